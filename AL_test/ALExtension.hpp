@@ -0,0 +1,181 @@
+#pragma once
+#include <cstdint>
+#ifdef _WIN32
+#include <alc.h>
+#include <al.h>
+#else
+#include <AL/alc.h>
+#include <AL/al.h>
+#endif
+
+//OpenAL Soft̊gŎg萔Ɗ֐^
+//ÂSDK̃wb_(alext.h)łrhł悤ɂŒ`Ă
+#ifndef AL_APIENTRY
+#define AL_APIENTRY
+#endif
+#ifndef ALC_APIENTRY
+#define ALC_APIENTRY
+#endif
+
+#ifndef AL_SOFT_events
+#define AL_EVENT_CALLBACK_FUNCTION_SOFT          0x19A2
+#define AL_EVENT_CALLBACK_USER_PARAM_SOFT        0x19A3
+#define AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT      0x19A4
+#define AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT  0x19A5
+#define AL_EVENT_TYPE_DISCONNECTED_SOFT          0x19A6
+typedef void (AL_APIENTRY* ALEVENTPROCSOFT)(ALenum eventType, ALuint object, ALuint param, ALsizei length, const ALchar* message, void* userParam);
+typedef void (AL_APIENTRY* LPALEVENTCONTROLSOFT)(ALsizei count, const ALenum* types, ALboolean enable);
+typedef void (AL_APIENTRY* LPALEVENTCALLBACKSOFT)(ALEVENTPROCSOFT callback, void* userParam);
+#endif
+
+#ifndef AL_SOFT_source_latency
+#define AL_SAMPLE_OFFSET_LATENCY_SOFT            0x1200
+#define AL_SEC_OFFSET_LATENCY_SOFT               0x1201
+typedef std::int64_t ALint64SOFT;
+typedef void (AL_APIENTRY* LPALGETSOURCEI64VSOFT)(ALuint source, ALenum param, ALint64SOFT* values);
+#endif
+
+#ifndef ALC_SOFT_loopback
+#define ALC_FORMAT_CHANNELS_SOFT                 0x1990
+#define ALC_FORMAT_TYPE_SOFT                     0x1991
+#define ALC_SHORT_SOFT                           0x1402
+#define ALC_FLOAT_SOFT                           0x1406
+#define ALC_MONO_SOFT                            0x1500
+#define ALC_STEREO_SOFT                          0x1501
+typedef ALCdevice* (ALC_APIENTRY* LPALCLOOPBACKOPENDEVICESOFT)(const ALCchar* deviceName);
+typedef ALCboolean (ALC_APIENTRY* LPALCISRENDERFORMATSUPPORTEDSOFT)(ALCdevice* device, ALCsizei freq, ALCenum channels, ALCenum type);
+typedef void (ALC_APIENTRY* LPALCRENDERSAMPLESSOFT)(ALCdevice* device, ALCvoid* buffer, ALCsizei samples);
+#endif
+
+#ifndef ALC_SOFT_device_clock
+#define ALC_DEVICE_CLOCK_SOFT                    0x1600
+typedef std::int64_t ALCint64SOFT;
+typedef void (ALC_APIENTRY* LPALCGETINTEGER64VSOFT)(ALCdevice* device, ALCenum pname, ALCsizei size, ALCint64SOFT* values);
+#endif
+
+#ifndef AL_SOFT_deferred_updates
+#define AL_DEFERRED_UPDATES_SOFT                 0xC002
+typedef void (AL_APIENTRY* LPALDEFERUPDATESSOFT)(void);
+typedef void (AL_APIENTRY* LPALPROCESSUPDATESSOFT)(void);
+#endif
+
+#ifndef AL_SOFT_loop_points
+#define AL_LOOP_POINTS_SOFT                      0x2015
+#endif
+
+#ifndef AL_EXT_IMA4
+#define AL_FORMAT_MONO_IMA4                      0x1300
+#define AL_FORMAT_STEREO_IMA4                    0x1301
+#endif
+
+#ifndef AL_EXT_float32
+#define AL_FORMAT_MONO_FLOAT32                   0x10010
+#define AL_FORMAT_STEREO_FLOAT32                 0x10011
+#endif
+
+//݂̃ReLXgŎggƁÅ֐|C^܂Ƃ߂Ď
+//ReLXgLoad()Ŏ擾
+struct ALExtension
+{
+	bool hasEvents;
+	bool hasSourceLatency;
+	bool hasLoopback;
+	//IMA ADPCM̂܂܃obt@ɓ
+	bool hasIma4;
+	//32bit float̂܂܃obt@ɓ
+	bool hasFloat32;
+	//\[X̕ύX܂Ƃ߂ă~LT[ɔf
+	bool hasDeferredUpdates;
+	//foCXۂɕ`悵Ԃ
+	bool hasDeviceClock;
+	//obt@̈ꕔ[vł
+	bool hasLoopPoints;
+
+	LPALEVENTCONTROLSOFT alEventControlSOFT;
+	LPALEVENTCALLBACKSOFT alEventCallbackSOFT;
+	LPALGETSOURCEI64VSOFT alGetSourcei64vSOFT;
+	LPALCLOOPBACKOPENDEVICESOFT alcLoopbackOpenDeviceSOFT;
+	LPALCISRENDERFORMATSUPPORTEDSOFT alcIsRenderFormatSupportedSOFT;
+	LPALCRENDERSAMPLESSOFT alcRenderSamplesSOFT;
+	LPALDEFERUPDATESSOFT alDeferUpdatesSOFT;
+	LPALPROCESSUPDATESSOFT alProcessUpdatesSOFT;
+	LPALCGETINTEGER64VSOFT alcGetInteger64vSOFT;
+
+	ALExtension()
+	{
+		hasEvents = false;
+		hasSourceLatency = false;
+		hasLoopback = false;
+		hasIma4 = false;
+		hasFloat32 = false;
+		hasDeferredUpdates = false;
+		hasDeviceClock = false;
+		hasLoopPoints = false;
+		alEventControlSOFT = nullptr;
+		alEventCallbackSOFT = nullptr;
+		alGetSourcei64vSOFT = nullptr;
+		alcLoopbackOpenDeviceSOFT = nullptr;
+		alcIsRenderFormatSupportedSOFT = nullptr;
+		alcRenderSamplesSOFT = nullptr;
+		alDeferUpdatesSOFT = nullptr;
+		alProcessUpdatesSOFT = nullptr;
+		alcGetInteger64vSOFT = nullptr;
+	}
+	//[vobN̓foCXJOɎĝŁAReLXgŎ擾
+	void LoadLoopback()
+	{
+		hasLoopback = alcIsExtensionPresent(nullptr, "ALC_SOFT_loopback") == ALC_TRUE;
+		if (hasLoopback)
+		{
+			alcLoopbackOpenDeviceSOFT = (LPALCLOOPBACKOPENDEVICESOFT)alcGetProcAddress(nullptr, "alcLoopbackOpenDeviceSOFT");
+			alcIsRenderFormatSupportedSOFT = (LPALCISRENDERFORMATSUPPORTEDSOFT)alcGetProcAddress(nullptr, "alcIsRenderFormatSupportedSOFT");
+			alcRenderSamplesSOFT = (LPALCRENDERSAMPLESSOFT)alcGetProcAddress(nullptr, "alcRenderSamplesSOFT");
+			hasLoopback = alcLoopbackOpenDeviceSOFT != nullptr && alcIsRenderFormatSupportedSOFT != nullptr && alcRenderSamplesSOFT != nullptr;
+		}
+	}
+	//foCX̊gȂ̂ŁAJfoCX擾
+	void LoadDeviceClock(ALCdevice* device)
+	{
+		hasDeviceClock = alcIsExtensionPresent(device, "ALC_SOFT_device_clock") == ALC_TRUE;
+		if (hasDeviceClock)
+		{
+			alcGetInteger64vSOFT = (LPALCGETINTEGER64VSOFT)alcGetProcAddress(device, "alcGetInteger64vSOFT");
+			hasDeviceClock = alcGetInteger64vSOFT != nullptr;
+		}
+	}
+	void Load()
+	{
+		hasEvents = alIsExtensionPresent("AL_SOFT_events") == AL_TRUE;
+		if (hasEvents)
+		{
+			alEventControlSOFT = (LPALEVENTCONTROLSOFT)alGetProcAddress("alEventControlSOFT");
+			alEventCallbackSOFT = (LPALEVENTCALLBACKSOFT)alGetProcAddress("alEventCallbackSOFT");
+			hasEvents = alEventControlSOFT != nullptr && alEventCallbackSOFT != nullptr;
+		}
+
+		hasSourceLatency = alIsExtensionPresent("AL_SOFT_source_latency") == AL_TRUE;
+		if (hasSourceLatency)
+		{
+			alGetSourcei64vSOFT = (LPALGETSOURCEI64VSOFT)alGetProcAddress("alGetSourcei64vSOFT");
+			hasSourceLatency = alGetSourcei64vSOFT != nullptr;
+		}
+
+		hasIma4 = alIsExtensionPresent("AL_EXT_IMA4") == AL_TRUE;
+		hasLoopPoints = alIsExtensionPresent("AL_SOFT_loop_points") == AL_TRUE;
+		hasFloat32 = alIsExtensionPresent("AL_EXT_FLOAT32") == AL_TRUE;
+
+		hasDeferredUpdates = alIsExtensionPresent("AL_SOFT_deferred_updates") == AL_TRUE;
+		if (hasDeferredUpdates)
+		{
+			alDeferUpdatesSOFT = (LPALDEFERUPDATESSOFT)alGetProcAddress("alDeferUpdatesSOFT");
+			alProcessUpdatesSOFT = (LPALPROCESSUPDATESSOFT)alGetProcAddress("alProcessUpdatesSOFT");
+			hasDeferredUpdates = alDeferUpdatesSOFT != nullptr && alProcessUpdatesSOFT != nullptr;
+		}
+	}
+	//vZXň (ReLXg蒼Load)
+	static ALExtension& Get()
+	{
+		static ALExtension extension;
+		return extension;
+	}
+};
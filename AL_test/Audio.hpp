@@ -3,12 +3,62 @@
 #include <fstream>
 #include <unordered_map>
 #include <mutex>
+#include <atomic>
 #include <thread>
+#include <condition_variable>
+#include <future>
 #include <string>
+#include <vector>
+#include <list>
+#include <functional>
+#include <memory>
+#include <deque>
+#include <sstream>
+#include <unordered_set>
+#include <cstring>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#ifdef _WIN32
 #include <conio.h>
 #include <alc.h>
 #include <al.h>
+#else
+//LinuxłOpenAL Soft̃wb_g
+#include <AL/alc.h>
+#include <AL/al.h>
+#endif
+#ifdef _MSC_VER
 #pragma comment(lib,"OpenAL32.lib")
+#endif
+//libvorbis̃wb_łOgg
+#if __has_include(<vorbis/vorbisfile.h>)
+#define AUDIO_USE_OGG 1
+#include <vorbis/vorbisfile.h>
+#ifdef _MSC_VER
+#pragma comment(lib,"libvorbisfile.lib")
+#pragma comment(lib,"libvorbis.lib")
+#pragma comment(lib,"libogg.lib")
+#endif
+#else
+#define AUDIO_USE_OGG 0
+#endif
+#include "MappedFile.hpp"
+#include "SoundScheduler.hpp"
+#include "ALExtension.hpp"
+#include "CommandRing.hpp"
+#include "WorkerPool.hpp"
+#include "SampleConverter.hpp"
+#include "SoundStats.hpp"
+#include "PrefetchRing.hpp"
+#include "SoftwareMixer.hpp"
+#include "Resampler.hpp"
+#include "ImaAdpcm.hpp"
+#include "SoundHandle.hpp"
+#include "WavWriter.hpp"
 
 enum class SoundFormat
 {
@@ -16,6 +66,48 @@ enum class SoundFormat
 	Mono16,
 	Stereo8,
 	Stereo16,
+	//AL_EXT_FLOAT32g鎞
+	MonoFloat32,
+	StereoFloat32,
+};
+//SoundFormat̃`lƃTv̌`𒲂ׂ
+struct SoundFormatInfo
+{
+	static int GetChannels(SoundFormat format)
+	{
+		return (format == SoundFormat::Stereo8 || format == SoundFormat::Stereo16 || format == SoundFormat::StereoFloat32) ? 2 : 1;
+	}
+	//1Tṽrbg (float32)
+	static int GetBits(SoundFormat format)
+	{
+		switch (format) {
+		case SoundFormat::Mono8:
+		case SoundFormat::Stereo8:
+			return 8;
+		case SoundFormat::MonoFloat32:
+		case SoundFormat::StereoFloat32:
+			return 32;
+		default:
+			return 16;
+		}
+	}
+	//16bitȂ(ϊIMA ADPCM)ɓnOɑ
+	//16bitȂpcm̂܂ܕԂAȊOworkɕϊĂ̐擪Ԃ
+	static const std::int16_t* ToS16(const char* pcm, size_t samples, SoundFormat format, std::vector<std::int16_t>* work)
+	{
+		switch (GetBits(format)) {
+		case 8:
+			work->resize(samples);
+			SampleConverter::U8ToS16((const std::uint8_t*)pcm, work->data(), samples);
+			return work->data();
+		case 32:
+			work->resize(samples);
+			SampleConverter::F32ToS16((const float*)pcm, work->data(), samples);
+			return work->data();
+		default:
+			return (const std::int16_t*)pcm;
+		}
+	}
 };
 struct AudioData
 {
@@ -23,10 +115,15 @@ struct AudioData
 	int pcmOffset;
 	int loopStart;
 	int loopLength;
+	//Read/ReadViewœn` (t@C̒gƈႤRead̒ŕϊ)
 	SoundFormat format;
 	int samplingRate;
 	int blockSize;
 	int dataStartOffset;
+	//t@C̃Tv (WAV̂)
+	int fileBits;
+	bool isFileFloat;
+	int fileBlockSize;
 };
 class IAudioData
 {
@@ -35,6 +132,14 @@ public:
 	virtual ~IAudioData() = default;
 	virtual bool LoadFile(const char* filePass) = 0;
 	virtual int Read(char* buffer, int maxSize) = 0;
+	//PCMRs[ɒڎQƂł͓ǂݍ݈ʒui߂Ă̐擪|C^Ԃ
+	//QƂłȂnullptrԂ̂Readg
+	virtual const char* ReadView(int maxSize, int* readSize)
+	{
+		(void)maxSize;
+		*readSize = 0;
+		return nullptr;
+	}
 	virtual void Seek(int pcmOffset) = 0;
 	virtual int GetPcmOffset() const = 0;
 	virtual int GetLoopStart() const = 0;
@@ -50,6 +155,8 @@ class WavData : public IAudioData
 private:
 	AudioData data_;
 	std::ifstream waveFile_;
+	//ϊ鎞Ƀt@Cǂ񂾂܂܂PCMu
+	std::vector<char> fileBuffer_;
 public:
 	WavData(const char* filePass)
 	{
@@ -65,16 +172,14 @@ public:
 
 	void Seek(int offset)
 	{
+		//I[𒴂I[ʒuɃV[N ([vI[̐Đ̂ŁAt@C̏I[Ő؂)
+		if (data_.pcmSize < offset)
+		{
+			offset = data_.pcmSize;
+		}
 		//t@C̐擪PCM܂ł̈ʒu܂ňړƂ (offset * blockSize) oCgړ
 		PcmSeek(offset);
 		data_.pcmOffset = offset;
-
-		//I[𒴂I[ʒuɃV[N
-		if (data_.loopLength < data_.pcmOffset)
-		{
-			data_.pcmOffset = data_.loopLength;
-			PcmSeek(data_.loopLength);
-		}
 	}
 	int Read(char* buffer, int maxSize)
 	{
@@ -84,23 +189,32 @@ public:
 			return 0;
 		}
 		int readSize = maxSize;
-		//I[𒴂Ȃ悤ɃTCY
-		if (data_.loopStart + data_.loopLength < data_.pcmOffset + readSize / data_.blockSize)
+		//I[𒴂Ȃ悤ɃTCY ([vI[Ő܂Ԃ͓ǂޑŌ߂)
+		if (data_.pcmSize < data_.pcmOffset + readSize / data_.blockSize)
 		{
-			readSize = (data_.loopLength - data_.pcmOffset) * data_.blockSize;
+			readSize = (data_.pcmSize - data_.pcmOffset) * data_.blockSize;
 		}
 
-		if (readSize == 0) 
+		if (readSize <= 0) 
 		{
 			return 0;
 		}
 
-		int prevOffset = data_.pcmOffset;
-		waveFile_.read(buffer, readSize);
-		data_.pcmOffset += readSize / data_.blockSize;
-
-		//ۂɓǂݍ񂾃TCY߂ĕԂ
-		return (data_.pcmOffset - prevOffset) * data_.blockSize;
+		//t@CrŐ؂ĂƗv菭ȂȂ̂ŁAۂɓǂݍ񂾃TCYԂ
+		int readBlock;
+		if (IsConverted(data_)) {
+			//t@Č`œǂłbufferɕϊ
+			fileBuffer_.resize((size_t)readSize / data_.blockSize * data_.fileBlockSize);
+			waveFile_.read(fileBuffer_.data(), fileBuffer_.size());
+			readBlock = (int)waveFile_.gcount() / data_.fileBlockSize;
+			DecodeSamples(data_, fileBuffer_.data(), buffer, readBlock);
+		}
+		else {
+			waveFile_.read(buffer, readSize);
+			readBlock = (int)waveFile_.gcount() / data_.blockSize;
+		}
+		data_.pcmOffset += readBlock;
+		return readBlock * data_.blockSize;
 	}
 
 	int GetPcmOffset() const override
@@ -138,48 +252,126 @@ public:
 	{
 		return data_.samplingRate;
 	}
-private:
-	bool LoadFile(const char* filePass)
+	//t@Č`Read/ReadViewœn`Ⴄ
+	static bool IsConverted(const AudioData& data)
+	{
+		return data.fileBlockSize != data.blockSize || data.isFileFloat != (SoundFormatInfo::GetBits(data.format) == 32);
+	}
+	//t@Č`framesgdata.formatɕϊdstɏ
+	static void DecodeSamples(const AudioData& data, const char* src, char* dst, int frames)
+	{
+		size_t samples = (size_t)frames * SoundFormatInfo::GetChannels(data.format);
+		bool isOutFloat = SoundFormatInfo::GetBits(data.format) == 32;
+		if (!IsConverted(data)) {
+			memcpy(dst, src, (size_t)frames * data.blockSize);
+		}
+		else if (data.isFileFloat) {
+			SampleConverter::F32ToS16((const float*)src, (std::int16_t*)dst, samples);
+		}
+		else if (isOutFloat) {
+			SampleConverter::S24ToF32((const std::uint8_t*)src, (float*)dst, samples);
+		}
+		else {
+			SampleConverter::S24ToS16((const std::uint8_t*)src, (std::int16_t*)dst, samples);
+		}
+	}
+	//t@C̃Tv(fileBitsisFileFloat)ARead/ReadViewœn`߂ (PackedBankƂL)
+	static void SetOutputFormat(AudioData* data, int numChannel)
+	{
+		bool isStereo = numChannel == 2;
+		data->fileBlockSize = numChannel * data->fileBits / 8;
+		if (data->fileBits == 8) {
+			data->format = isStereo ? SoundFormat::Stereo8 : SoundFormat::Mono8;
+		}
+		else if (data->fileBits == 16 || !ALExtension::Get().hasFloat32) {
+			data->format = isStereo ? SoundFormat::Stereo16 : SoundFormat::Mono16;
+		}
+		else {
+			data->format = isStereo ? SoundFormat::StereoFloat32 : SoundFormat::MonoFloat32;
+		}
+		data->blockSize = numChannel * SoundFormatInfo::GetBits(data->format) / 8;
+	}
+	//wave̊e`NǂAudioData𖄂߂ (MappedWavDataƂL)
+	//8/16bitPCM͂̂܂܁A24bitPCM32bit floatAL_EXT_FLOAT32floatA16bitœn
+	//WAVE_FORMAT_EXTENSIBLESubFormat̐擪2oCgʏ̃tH[}bgIDƓȂ̂ŁAŔf
+	static bool ParseHeader(std::istream& waveFile, AudioData* data)
 	{
 		//e`N̐擪ɂ̏񂪕K
 		struct WaveChunk {
 			char id[4];
-			int size;
+			std::int32_t size;
 		};
 		//fmt`Np̍\
 		struct WaveStruct {
-			unsigned short formatId;           //tH[}bgID
-			unsigned short numChannel;			//`l monaural=1 , stereo=2
-			unsigned long  samplingRate;	 //PbԂ̃TvCTvO[g(Hz)
-			unsigned long  bytesPerSec;       //PbԂ̃f[^TCY
-			unsigned short blockSize;          //PubÑTCYD8bit:nomaural=1byte , 16bit:stereo=4byte
-			unsigned short bitsPerSample;     //PTṽrbg 8bit or 16bit
+			std::uint16_t formatId;           //tH[}bgID
+			std::uint16_t numChannel;			//`l monaural=1 , stereo=2
+			std::uint32_t samplingRate;	 //PbԂ̃TvCTvO[g(Hz)
+			std::uint32_t bytesPerSec;       //PbԂ̃f[^TCY
+			std::uint16_t blockSize;          //PubÑTCYD8bit:nomaural=1byte , 16bit:stereo=4byte
+			std::uint16_t bitsPerSample;     //PTṽrbg 8bit or 16bit or 24bit or 32bit
+			//ȉWAVE_FORMAT_EXTENSIBLE̎
+			std::uint16_t extensionSize;
+			std::uint16_t validBits;
+			std::uint32_t channelMask;
+			std::uint8_t subFormat[16];
 			WaveStruct():
 			formatId(0),
 			numChannel(0),
 			samplingRate(0),
 			bytesPerSec(0),
 			blockSize(0),
-			bitsPerSample(0)
+			bitsPerSample(0),
+			extensionSize(0),
+			validBits(0),
+			channelMask(0),
+			subFormat()
 			{}
 		};
+		const std::uint16_t FormatPcm = 1;
+		const std::uint16_t FormatFloat = 3;
+		const std::uint16_t FormatExtensible = 0xFFFE;
+		//smpl`N̐擪 (̌Ƀ[vnumSampleLoops)
+		struct SampleStruct {
+			std::uint32_t manufacturer;
+			std::uint32_t product;
+			std::uint32_t samplePeriod;
+			std::uint32_t midiUnityNote;
+			std::uint32_t midiPitchFraction;
+			std::uint32_t smpteFormat;
+			std::uint32_t smpteOffset;
+			std::uint32_t numSampleLoops;
+			std::uint32_t samplerData;
+		};
+		//smpl`Ñ[v (start,end̓TvPʂŁAend̃Tv܂ł܂)
+		struct SampleLoop {
+			std::uint32_t cuePointId;
+			std::uint32_t type;
+			std::uint32_t start;
+			std::uint32_t end;
+			std::uint32_t fraction;
+			std::uint32_t playCount;
+		};
+		//cue`N̈ʒu (̑OɌ4oCg)
+		struct CuePoint {
+			std::uint32_t id;
+			std::uint32_t position;
+			char chunkId[4];
+			std::uint32_t chunkStart;
+			std::uint32_t blockStart;
+			std::uint32_t sampleOffset;
+		};
 
-
-		waveFile_.open(filePass, std::ifstream::binary);
-		if (!waveFile_) {
-			return false;
-		}
 		//RIFF`N̐擪12oCg
 		//id = 4bite : size = 4bite;
 		WaveChunk chunk;
 		WaveStruct fmtChunk;
 		char format[4];
 
-		waveFile_.read((char*)&chunk, 8);
-		waveFile_.read(format, 4);
+		waveFile.read((char*)&chunk, 8);
+		waveFile.read(format, 4);
 
 		//WAVEtH[}bgȊO͎s
-		if (strncmp(chunk.id, "RIFF", 4) != 0 || strncmp(format, "WAVE", 4)) {
+		if (!waveFile || strncmp(chunk.id, "RIFF", 4) != 0 || strncmp(format, "WAVE", 4)) {
 			return false;
 		}
 
@@ -188,490 +380,3831 @@ private:
 		int byteOffset = 12;
 		int dataSize = 0;
 		int fileSize = chunk.size;
+		//[v|Cg (Ȃ-1)
+		int sampleLoopStart = -1;
+		int sampleLoopEnd = -1;
+		std::vector<int> cuePoints;
 		while (byteOffset < fileSize) {
-			waveFile_.read((char*)&chunk, sizeof(WaveChunk));
+			if (!waveFile.read((char*)&chunk, sizeof(WaveChunk))) {
+				break;
+			}
+			//`N2oCgEɑ̂ŁATCY̌ɂ͋lߕ1oCg
+			int paddedSize = chunk.size + (chunk.size & 1);
+			if (strncmp(chunk.id, "smpl", 4) == 0) {
+				//smpl`N
+				//ŏ̃[vg
+				SampleStruct sample = {};
+				SampleLoop loop = {};
+				int readSize = 0;
+				if (chunk.size >= (int)(sizeof(SampleStruct) + sizeof(SampleLoop))) {
+					waveFile.read((char*)&sample, sizeof(SampleStruct));
+					readSize += sizeof(SampleStruct);
+					if (sample.numSampleLoops > 0) {
+						waveFile.read((char*)&loop, sizeof(SampleLoop));
+						readSize += sizeof(SampleLoop);
+						sampleLoopStart = (int)loop.start;
+						sampleLoopEnd = (int)loop.end;
+					}
+				}
+				waveFile.seekg(paddedSize - readSize, std::ios_base::cur);
+				byteOffset += paddedSize + sizeof(WaveChunk);
+				continue;
+			}
+			if (strncmp(chunk.id, "cue ", 4) == 0) {
+				//cue`N
+				std::uint32_t numCuePoint = 0;
+				int readSize = 0;
+				if (chunk.size >= 4) {
+					waveFile.read((char*)&numCuePoint, 4);
+					readSize += 4;
+				}
+				for (std::uint32_t i = 0; i < numCuePoint && readSize + (int)sizeof(CuePoint) <= chunk.size; ++i) {
+					CuePoint cue = {};
+					waveFile.read((char*)&cue, sizeof(CuePoint));
+					readSize += sizeof(CuePoint);
+					cuePoints.push_back((int)cue.sampleOffset);
+				}
+				waveFile.seekg(paddedSize - readSize, std::ios_base::cur);
+				byteOffset += paddedSize + sizeof(WaveChunk);
+				continue;
+			}
 			if (strncmp(chunk.id, "fmt ", 4) == 0) {
 				//fmt`N
-				waveFile_.read((char*)&fmtChunk, chunk.size);
-				if (fmtChunk.formatId != 1) {
+				//WAVE_FORMAT_EXTENSIBLEȂSubFormat܂œǂށB͎gȂ̂œǂݔ΂
+				int fmtSize = chunk.size < (int)sizeof(WaveStruct) ? chunk.size : (int)sizeof(WaveStruct);
+				waveFile.read((char*)&fmtChunk, fmtSize);
+				waveFile.seekg(paddedSize - fmtSize, std::ios_base::cur);
+				if (fmtChunk.formatId == FormatExtensible) {
+					if (fmtSize < (int)sizeof(WaveStruct)) {
+						return false;
+					}
+					fmtChunk.formatId = (std::uint16_t)(fmtChunk.subFormat[0] | (fmtChunk.subFormat[1] << 8));
+				}
+				if (fmtChunk.formatId != FormatPcm && fmtChunk.formatId != FormatFloat) {
 					return false;
 				}
-				byteOffset += chunk.size + sizeof(WaveChunk);
+				byteOffset += paddedSize + sizeof(WaveChunk);
 				++count;
 			}
 			else if (strncmp(chunk.id, "data ", 4) == 0) {
 				//data`N
 				//ʒuۑĒǂݍݗp̃f[^ɗp
-				data_.dataStartOffset = byteOffset + sizeof(WaveChunk);
-				waveFile_.seekg(chunk.size, std::ios_base::cur);
-				byteOffset += chunk.size + sizeof(WaveChunk);
+				data->dataStartOffset = byteOffset + sizeof(WaveChunk);
+				waveFile.seekg(paddedSize, std::ios_base::cur);
+				byteOffset += paddedSize + sizeof(WaveChunk);
 				dataSize = chunk.size;
 				++count;
 			}
 			else {
 				//ȊÕ`N̓XLbv
-				waveFile_.seekg(chunk.size, std::ios_base::cur);
-				byteOffset += chunk.size + sizeof(WaveChunk);
+				waveFile.seekg(paddedSize, std::ios_base::cur);
+				byteOffset += paddedSize + sizeof(WaveChunk);
 			}
 		}
 
 		//fmt,datã`N킹ĂQłȂ͎s
-		if (count != 2) {
+		if (count != 2 || fmtChunk.blockSize == 0) {
 			return false;
 		}
-
-		data_.samplingRate = fmtChunk.samplingRate;
-		if (fmtChunk.numChannel == 1) {
-			//m
-			if (fmtChunk.bitsPerSample == 8) {
-				data_.format = SoundFormat::Mono8;
-			};
-			if (fmtChunk.bitsPerSample == 16) {
-				data_.format = SoundFormat::Mono16;
-			};
-		}
-		else {
-			//XeI
-			if (fmtChunk.bitsPerSample == 8) {
-				data_.format = SoundFormat::Stereo8;
-			};
-			if (fmtChunk.bitsPerSample == 16) {
-				data_.format = SoundFormat::Stereo16;
-			};
+		//ΉĂ̂̓mƃXeÍA8/16/24bitPCM32bit float
+		bool isFloat = fmtChunk.formatId == FormatFloat;
+		int bits = fmtChunk.bitsPerSample;
+		if ((fmtChunk.numChannel != 1 && fmtChunk.numChannel != 2)
+			|| (isFloat && bits != 32)
+			|| (!isFloat && bits != 8 && bits != 16 && bits != 24)
+			|| fmtChunk.blockSize != fmtChunk.numChannel * bits / 8) {
+			return false;
 		}
 
-		data_.blockSize = fmtChunk.blockSize;
+		data->samplingRate = fmtChunk.samplingRate;
+		data->fileBits = bits;
+		data->isFileFloat = isFloat;
+		SetOutputFormat(data, fmtChunk.numChannel);
+		data->pcmSize = dataSize / data->fileBlockSize;
 
-		//oggƈĂ̓[v|CgŏƍŌŌŒ
-		data_.loopStart = 0;
-		data_.loopLength = data_.loopStart + dataSize / data_.blockSize;
+		//[v|Cgsmpl`N̍ŏ̃[v
+		//smplcue2ȏ゠鎞Aɍŏ2̊Ԃ[v (1cue̖͂ڈƂĈ)
+		//ǂ͈͊OȂŏŌ܂
+		data->loopStart = 0;
+		data->loopLength = data->pcmSize;
+		int loopStart = -1;
+		int loopEnd = -1;
+		if (sampleLoopStart >= 0) {
+			loopStart = sampleLoopStart;
+			loopEnd = sampleLoopEnd + 1;
+		}
+		else if (cuePoints.size() > 1) {
+			std::sort(cuePoints.begin(), cuePoints.end());
+			loopStart = cuePoints[0];
+			loopEnd = cuePoints[1];
+		}
+		if (0 <= loopStart && loopStart < loopEnd && loopEnd <= data->pcmSize) {
+			data->loopStart = loopStart;
+			data->loopLength = loopEnd - loopStart;
+		}
+		return true;
+	}
+private:
+	bool LoadFile(const char* filePass)
+	{
+		waveFile_.open(filePass, std::ifstream::binary);
+		if (!waveFile_) {
+			return false;
+		}
+		if (!ParseHeader(waveFile_, &data_)) {
+			return false;
+		}
+		//wb_ǂޓrŏI[ɒBĂ邱Ƃ̂ŃV[NOɏԂ߂
+		waveFile_.clear();
 
 		Seek(0);
 		return true;
 	}
 	void PcmSeek(int pcmOffset)
 	{
-		waveFile_.seekg(data_.dataStartOffset + pcmOffset * data_.blockSize, std::ios_base::beg);
+		waveFile_.seekg(data_.dataStartOffset + (std::streamoff)pcmOffset * data_.fileBlockSize, std::ios_base::beg);
 	}
 };
 
-//w肳ꂽt@CpX̊gqpēK؂AudioLoader𐶐t@Ng[
-class AudioDataFactory {
-public:
-	enum AudioType {
-		Wave,
-		Ogg,
-		NonSupport,
-	};
-
+//}bvt@C̒ɂPCMǂ (MappedWavDataBankAudioDataŋL)
+//ReadViewŃ}bv̈̂܂ܕԂ̂alBufferData܂ŃRs[Ȃ
+//(ϊv`ReadViewgAReadŃ}bv̈悩璼ڕϊď)
+class MappedPcmData : public IAudioData
+{
+protected:
+	AudioData data_;
+	//}bv̈̒PCM̐擪
+	const char* pcm_;
 public:
-	AudioDataFactory() = default;
-	~AudioDataFactory() = default;
-	IAudioData* Create(const char* filePass)
+	MappedPcmData()
 	{
-		IAudioData* data=nullptr;
-
-		switch (CheckType(filePass))
-		{
-		case AudioType::Wave:
-			data = new WavData(filePass);
-			break;
-		case AudioType::Ogg:
-		
-			break;
-
-		case AudioType::NonSupport:
-		default:
-			data = nullptr;
-		}
-
-		return data;
+		data_ = AudioData();
+		pcm_ = nullptr;
 	}
-private:
-	AudioType CheckType(const char* filePass)
-	{
-		//gq͏߂́u.vI[܂ł̕Ƃ
-		int i = 0;
-		char ext[16] = {};
-		while (filePass[i] != '.') {
-			++i;
-		}
-		//hbg͔΂
-		++i;
 
-		//I[܂ŃRs[
-		int extCount = 0;
-		while (filePass[i] != 0 && extCount < 15) {
-			ext[extCount] = filePass[i];
-			++extCount;
-			++i;
-		}
-		ext[extCount] = 0;
+	void Seek(int offset)
+	{
+		data_.pcmOffset = offset;
 
-		AudioType type = AudioType::NonSupport;
-		if (strcmp(ext, "ogg") == 0) {
-			type = AudioType::Ogg;
-		}
-		if (strcmp(ext, "wav") == 0) {
-			type = AudioType::Wave;
+		//I[𒴂I[ʒuɃV[N
+		if (data_.pcmSize < data_.pcmOffset)
+		{
+			data_.pcmOffset = data_.pcmSize;
 		}
-
-		return type;
 	}
-};
-class SoundSource
-{
-public:
-	enum LoadMode {
-		Streaming,
-		AllRead,
-	};
-private:
-	const std::string name_;
-	IAudioData* audio_;
-	LoadMode mode_;
-	std::vector<char> allReadData_;
-	//CopyPlayp̊ǗXg
-	std::list<ALuint> copySources_;
-
-	std::thread* thread_;
-	std::recursive_mutex mutex_;
-
-	ALuint sourceID_;
-	ALuint *bufferIDs_;
-	int numBuffer_;
-
-	ALuint format_;
-
-	float volume_;
-	float posX_, posY_, posZ_;
-	float velocityX_, velocityY_, velocityZ_;
-
-	bool isPlayed_;
-	bool isLoop_;
-	bool isEnd_;
-public:
-	SoundSource(const char* filePass, LoadMode mode, int numBuffer = 32)
+	int Read(char* buffer, int maxSize)
 	{
-		bufferIDs_ = new ALuint[numBuffer];
-		isPlayed_ = false;
-		isLoop_ = false;
-		isEnd_ = false;
-		numBuffer = numBuffer;
-		mode = mode;
-
-
-		alGenSources(1, &sourceID_);
-		alDistanceModel(AL_EXPONENT_DISTANCE);
-
-		//ǂݍ
-		AudioDataFactory factory;
-		audio_ = factory.Create(filePass);
-
-		if (audio_->GetFormat() == SoundFormat::Stereo16) {
-			format_ = AL_FORMAT_STEREO16;
-		}
-		else {
-			format_ = AL_FORMAT_MONO16;
-		}
-		//obt@Oǂݍ
-		switch (mode) {
-		case LoadMode::Streaming:
-			//Xg[~O[h̓obt@ăL[
-			char buffer[4096];
-			for (int i = 0; i < numBuffer; ++i) {
-				alGenBuffers(1, &bufferIDs_[i]);
-				int readSize = ReadBuffer(buffer, 4096);
-				alBufferData(bufferIDs_[i], format_, buffer, readSize, audio_->GetSamplingRate());
-				alSourceQueueBuffers(sourceID_, 1, &bufferIDs_[i]);
-			}
-			//XbhJn (XbhɃo[֐w肷ۂ͑this|C^[w肷)
-			thread_ = new std::thread(&SoundSource::StreamingThread, this);
-			break;
-
-		case LoadMode::AllRead:
-			//I[[h[hׂ͂ēǂŃobt@ɓ˂
-			int size = audio_->GetLoopLength() * audio_->GetBlockSize();
-			allReadData_.resize(size);
-			int readSize = ReadBuffer(allReadData_.data(), size);
-			alGenBuffers(1, &bufferIDs_[0]);
-			alBufferData(bufferIDs_[0], format_, allReadData_.data(), readSize, audio_->GetSamplingRate());
-			alSourcei(sourceID_, AL_BUFFER, bufferIDs_[0]);
-			numBuffer = 1;
-			thread_ = new std::thread(&SoundSource::AllReadThread, this);
-			break;
+		const char* view = pcm_ + (size_t)data_.pcmOffset * data_.fileBlockSize;
+		int readBlock = Advance(maxSize);
+		if (readBlock > 0)
+		{
+			WavData::DecodeSamples(data_, view, buffer, readBlock);
 		}
+		return readBlock * data_.blockSize;
 	}
-	~SoundSource()
+	const char* ReadView(int maxSize, int* readSize) override
 	{
-		EndThread();
-
-		if (thread_ != nullptr)
+		*readSize = 0;
+		if (WavData::IsConverted(data_))
 		{
-			thread_->join();
-			delete thread_;
-			thread_ = nullptr;
+			return nullptr;
 		}
-		delete audio_;
-
-		alDeleteBuffers(numBuffer_, bufferIDs_);
-		alDeleteSources(1, &sourceID_);
+		const char* view = pcm_ + (size_t)data_.pcmOffset * data_.blockSize;
+		*readSize = Advance(maxSize) * data_.blockSize;
+		return view;
+	}
 
-		delete[] bufferIDs_;
+	int GetPcmOffset() const override
+	{
+		return data_.pcmOffset;
 	}
-	void Play(bool loop)
+
+	int GetLoopStart() const override
 	{
-		ALint state;
-		alGetSourcei(sourceID_, AL_SOURCE_STATE, &state);
-		if (state == AL_PLAYING)
-		{
-			return;
-		}
-		
-		
-		alSourcePlay(sourceID_);
-		std::lock_guard<std::recursive_mutex> lock(mutex_);
-		isPlayed_ = true;
-		isLoop_ = loop;
+		return data_.loopStart;
 	}
-	void PlayCopy()
+
+	int GetLoopLength() const override
 	{
-		//Xg[~O[hł͗płȂ
-		if (mode_ == LoadMode::Streaming) 
-		{
-			return;
-		}
-		ALuint source;
-		{
-			std::lock_guard<std::recursive_mutex> lock(mutex_);
-			isPlayed_ = true;
-			isLoop_ = false;
-			alGenSources(1, &source);
-			alSourcei(source, AL_BUFFER, bufferIDs_[0]);
-			copySources_.push_back(source);
-		}
-		alSourcePlay(source);
+		return data_.loopLength;
 	}
-	void Pause()
+
+	int GetPcmSize() const override
 	{
-		alSourceStop(sourceID_);
-		{
-			std::lock_guard<std::recursive_mutex> lock(mutex_);
-			isPlayed_ = false;
-		}
+		return data_.pcmSize;
 	}
 
-	void Stop()
+	int GetBlockSize() const override
 	{
-		std::lock_guard<std::recursive_mutex> lock(mutex_);
-		isPlayed_ = false;
-		//obt@
-		int num;
-		ALuint soundBuffer;
-		while (alGetSourcei(sourceID_, AL_BUFFERS_PROCESSED, &num), num > 0) {
-			alSourceUnqueueBuffers(sourceID_, 1, &soundBuffer);
-		}
+		return data_.blockSize;
+	}
 
-		alSourceStop(sourceID_);
+	SoundFormat GetFormat() const override
+	{
+		return data_.format;
+	}
 
-		audio_->Seek(0);
-		char buffer[4096];
-		for (int i = 0; i < numBuffer_; ++i) 
-		{
-			int readSize = ReadBuffer(buffer, 4096);
-			alBufferData(bufferIDs_[i], format_, buffer, readSize, audio_->GetSamplingRate());
-			alSourceQueueBuffers(sourceID_, 1, &bufferIDs_[i]);
-		}
+	int GetSamplingRate() const override
+	{
+		return data_.samplingRate;
 	}
-	void SetVolume(float volume)
+protected:
+	//ǂݍ݈ʒumaxSize(I[܂)i߂āAi߂ubNԂ
+	int Advance(int maxSize)
 	{
-		alSourcef(sourceID_, AL_MAX_GAIN, volume);
+		//ǂݍ݃TCYPCM̈TCYŊ؂ȂȂ玸s
+		if (maxSize % data_.blockSize != 0)
 		{
-			std::lock_guard<std::recursive_mutex> lock(mutex_);
-			volume_ = volume;
+			return 0;
 		}
-	}
-	void SetPosition(float x, float y, float z)
-	{
-		alSource3f(sourceID_, AL_POSITION, x, y, z);
+		//I[𒴂Ȃ悤ɃTCY
+		int readBlock = maxSize / data_.blockSize;
+		if (data_.pcmSize < data_.pcmOffset + readBlock)
+		{
+			readBlock = data_.pcmSize - data_.pcmOffset;
+		}
+		if (readBlock < 0)
 		{
-			std::lock_guard<std::recursive_mutex> lock(mutex_);
-			posX_ = x;
-			posY_ = y;
-			posZ_ = z;
+			readBlock = 0;
 		}
+		data_.pcmOffset += readBlock;
+		return readBlock;
 	}
-	void SetVelocity(float x, float y, float z)
+};
+//Wavet@CɃ}bvĕێ
+class MappedWavData : public MappedPcmData
+{
+private:
+	MappedFile file_;
+public:
+	MappedWavData(const char* filePass)
 	{
-		alSource3f(sourceID_, AL_VELOCITY, x, y, z);
+		if (!LoadFile(filePass))
 		{
-			std::lock_guard<std::recursive_mutex> lock(mutex_);
-			velocityX_ = x;
-			velocityY_ = y;
-			velocityZ_ = z;
+			throw("can't map wav" + std::string(filePass));
 		}
 	}
-	bool IsPlay()
+	~MappedWavData()
 	{
-		std::lock_guard<std::recursive_mutex> lock(mutex_);
-		return isPlayed_;
+		file_.Close();
 	}
-
 private:
-	void StreamingThread()
+	bool LoadFile(const char* filePass)
 	{
-		while (!isEnd_) {
-			if (!isPlayed_) {
-				//X[v͂1t[̃EFCg
-				std::this_thread::sleep_for(std::chrono::milliseconds(16));
-				continue;
-			}
-
-			ALint state;
-			alGetSourcei(sourceID_, AL_SOURCE_STATE, &state);
-
-			if (state != AL_PLAYING) {
-				alSourcePlay(sourceID_);
-			}
-			else {
-				FillBuffer();
+		//wb_̉͂WavDataƋ
+		{
+			std::ifstream waveFile(filePass, std::ifstream::binary);
+			if (!waveFile || !WavData::ParseHeader(waveFile, &data_)) {
+				return false;
 			}
 		}
-	}
-	void AllReadThread()
+		if (!file_.Open(filePass)) {
+			return false;
+		}
+		//data`Nt@C̓rŐ؂Ă̂̓}bv͈͂Ɏ܂镪
+		if (file_.GetSize() < (size_t)data_.dataStartOffset) {
+			return false;
+		}
+		size_t available = file_.GetSize() - data_.dataStartOffset;
+		if ((size_t)data_.pcmSize * data_.fileBlockSize > available) {
+			data_.pcmSize = (int)(available / data_.fileBlockSize);
+			//[v؂ꂽɂĂ܂镪ɂ
+			if (data_.loopStart >= data_.pcmSize) {
+				data_.loopStart = 0;
+			}
+			if (data_.loopStart + data_.loopLength > data_.pcmSize) {
+				data_.loopLength = data_.pcmSize - data_.loopStart;
+			}
+		}
+		pcm_ = file_.GetData() + data_.dataStartOffset;
+
+		Seek(0);
+		return true;
+	}
+};
+
+//AL_test packōAWAV܂Ƃ߂1̃t@C (gq.sbk)
+//wb_[AOɕׂAO\A4KBEɑPCM̏ɕ (lׂ͂ăgGfBA)
+//ɂWAṼwb_[͂ʂ̂ŁAǂݍݎɃ`NHȂĂ悢
+//PCMWAVdata`N̂܂ܒûŁA24bitfloat͓ǂގɕϊ
+struct PackedBankFormat
+{
+	static const std::uint32_t Version = 1;
+	static const int Alignment = 4096;
+
+	struct Header
+	{
+		char magic[4];
+		std::uint32_t version;
+		std::uint32_t numEntry;
+		//O\̃oCg (̒ɒu)
+		std::uint32_t nameBytes;
+	};
+	struct Entry
+	{
+		//SoundId::Hash̒l
+		std::uint32_t nameHash;
+		//O\̒̈ʒuƒ (I[0͊܂܂Ȃ)
+		std::uint32_t nameOffset;
+		std::uint32_t nameLength;
+		std::uint32_t samplingRate;
+		std::uint16_t numChannel;
+		std::uint16_t fileBits;
+		std::uint16_t isFileFloat;
+		std::uint16_t reserved0;
+		std::int32_t pcmSize;
+		std::int32_t loopStart;
+		std::int32_t loopLength;
+		std::uint32_t reserved1;
+		//t@C̐擪PCM̈ʒu (Alignment̔{) ƃoCg
+		std::uint64_t dataOffset;
+		std::uint64_t dataBytes;
+	};
+	static_assert(sizeof(Header) == 16, "PackedBankFormat::Header layout");
+	static_assert(sizeof(Entry) == 56, "PackedBankFormat::Entry layout");
+
+	static bool IsMagic(const char* magic)
+	{
+		return strncmp(magic, "SBNK", 4) == 0;
+	}
+};
+//PackedBank̒1̉ǂ
+//}bv̈̓oNƋLAŌɎgĂ̂jꂽɊO
+class BankAudioData : public MappedPcmData
+{
+private:
+	std::shared_ptr<MappedFile> file_;
+public:
+	BankAudioData(const std::shared_ptr<MappedFile>& file, const AudioData& data, const char* pcm) :
+		file_(file)
+	{
+		data_ = data;
+		pcm_ = pcm;
+		Seek(0);
+	}
+	~BankAudioData() = default;
+	//oN̒̉PackedBank::Createō̂ŁAt@C͊JȂ
+	bool LoadFile(const char* filePass) override
+	{
+		(void)filePass;
+		return false;
+	}
+};
+//PackedBankFormat̃t@C1񂾂}bvāẢBankAudioDataƂč
+//OpenȊOconstȂ̂ŁAJ͕̃Xbh瓯CreateĂ悢
+class PackedBank
+{
+private:
+	std::shared_ptr<MappedFile> file_;
+	std::vector<PackedBankFormat::Entry> entries_;
+	const char* names_;
+
+	//ꉞRs[֎~
+	PackedBank(const PackedBank&) = delete;
+	PackedBank& operator=(const PackedBank&) = delete;
+public:
+	PackedBank()
+	{
+		names_ = nullptr;
+	}
+	~PackedBank() = default;
+	//wb_[ƍĂg悤ɂBĂfalse
+	bool Open(const char* filePass)
+	{
+		Close();
+		std::shared_ptr<MappedFile> file = std::make_shared<MappedFile>();
+		if (!file->Open(filePass) || file->GetSize() < sizeof(PackedBankFormat::Header)) {
+			return false;
+		}
+		PackedBankFormat::Header header;
+		memcpy(&header, file->GetData(), sizeof(header));
+		if (!PackedBankFormat::IsMagic(header.magic) || header.version != PackedBankFormat::Version) {
+			return false;
+		}
+		size_t size = file->GetSize();
+		size_t indexOffset = sizeof(PackedBankFormat::Header);
+		size_t nameOffset = indexOffset + (size_t)header.numEntry * sizeof(PackedBankFormat::Entry);
+		if (header.numEntry > size / sizeof(PackedBankFormat::Entry) || nameOffset + header.nameBytes > size) {
+			return false;
+		}
+		//͏̂ŁAECɂɓǂ߂悤茳ɎʂĂ
+		std::vector<PackedBankFormat::Entry> entries(header.numEntry);
+		if (header.numEntry > 0) {
+			memcpy(entries.data(), file->GetData() + indexOffset, entries.size() * sizeof(PackedBankFormat::Entry));
+		}
+		const char* names = file->GetData() + nameOffset;
+		for (size_t i = 0; i < entries.size(); ++i) {
+			if (!IsValid(entries[i], names, header.nameBytes, size)) {
+				return false;
+			}
+			//OłȂΒTȂ
+			if (i > 0 && strcmp(names + entries[i - 1].nameOffset, names + entries[i].nameOffset) >= 0) {
+				return false;
+			}
+		}
+		file_ = file;
+		entries_.swap(entries);
+		names_ = names;
+		return true;
+	}
+	//BankAudioData̓}bv̈̂ŁAg
+	void Close()
+	{
+		file_.reset();
+		entries_.clear();
+		names_ = nullptr;
+	}
+	bool IsOpen() const
+	{
+		return file_ != nullptr;
+	}
+	int GetCount() const
+	{
+		return (int)entries_.size();
+	}
+	const char* GetName(int index) const
+	{
+		return names_ + entries_[index].nameOffset;
+	}
+	//OY (-1)
+	int Find(const char* name) const
+	{
+		int low = 0;
+		int high = (int)entries_.size();
+		while (low < high) {
+			int middle = (low + high) / 2;
+			int order = strcmp(GetName(middle), name);
+			if (order == 0) {
+				return middle;
+			}
+			if (order < 0) {
+				low = middle + 1;
+			}
+			else {
+				high = middle;
+			}
+		}
+		return -1;
+	}
+	//indexԖڂ̉ǂރf[^ (͈͊OȂnullptr)
+	IAudioData* Create(int index) const
+	{
+		if (index < 0 || index >= (int)entries_.size()) {
+			return nullptr;
+		}
+		const PackedBankFormat::Entry& entry = entries_[index];
+		AudioData data = AudioData();
+		data.samplingRate = (int)entry.samplingRate;
+		data.fileBits = entry.fileBits;
+		data.isFileFloat = entry.isFileFloat != 0;
+		WavData::SetOutputFormat(&data, entry.numChannel);
+		data.pcmSize = entry.pcmSize;
+		data.loopStart = entry.loopStart;
+		data.loopLength = entry.loopLength;
+		//}bv̈̒𒼐ڎŵŁAt@C̈ʒu͎gȂ
+		data.dataStartOffset = 0;
+		return new BankAudioData(file_, data, file_->GetData() + entry.dataOffset);
+	}
+	IAudioData* Create(const char* name) const
+	{
+		return Create(Find(name));
+	}
+private:
+	static bool IsValid(const PackedBankFormat::Entry& entry, const char* names, std::uint32_t nameBytes, size_t size)
+	{
+		//O͖O\Ɏ܂A0ŏIĂ邱
+		if ((std::uint64_t)entry.nameOffset + entry.nameLength >= nameBytes || names[entry.nameOffset + entry.nameLength] != '\0') {
+			return false;
+		}
+		//WavData::ParseHeader󂯕t̂Ɠ`
+		bool isFloat = entry.isFileFloat != 0;
+		if ((entry.numChannel != 1 && entry.numChannel != 2)
+			|| (isFloat && entry.fileBits != 32)
+			|| (!isFloat && entry.fileBits != 8 && entry.fileBits != 16 && entry.fileBits != 24)
+			|| entry.samplingRate == 0) {
+			return false;
+		}
+		std::uint64_t fileBlockSize = (std::uint64_t)entry.numChannel * entry.fileBits / 8;
+		if (entry.dataOffset % PackedBankFormat::Alignment != 0 || entry.dataOffset > size || entry.dataBytes > size - entry.dataOffset
+			|| entry.pcmSize < 0 || (std::uint64_t)entry.pcmSize * fileBlockSize > entry.dataBytes) {
+			return false;
+		}
+		return entry.loopStart >= 0 && entry.loopLength >= 0 && (std::int64_t)entry.loopStart + entry.loopLength <= entry.pcmSize;
+	}
+};
+
+#if AUDIO_USE_OGG
+//Ogg Vorbis𒀎fR[hăf[^ێS
+//Read̒ŕKvȕfR[ĥŃt@CŜWJȂ
+class OggData : public IAudioData
+{
+private:
+	AudioData data_;
+	OggVorbis_File file_;
+	bool isOpen_;
+	//XeIׂOɍE16bitɂĂƗ̈
+	std::vector<std::int16_t> planar_;
+public:
+	OggData(const char* filePass)
+	{
+		isOpen_ = false;
+		if (!LoadFile(filePass))
+		{
+			//JŒéAOŔƃfXgN^Ă΂Ȃ̂łŕ
+			if (isOpen_)
+			{
+				ov_clear(&file_);
+				isOpen_ = false;
+			}
+			throw("not ogg" + std::string(filePass));
+		}
+	}
+	~OggData()
+	{
+		if (isOpen_)
+		{
+			ov_clear(&file_);
+		}
+	}
+
+	void Seek(int offset)
+	{
+		//I[𒴂I[ʒuɃV[N
+		if (data_.pcmSize < offset)
+		{
+			offset = data_.pcmSize;
+		}
+		//ov_pcm_seek̓TvPʂŐmɈړł
+		ov_pcm_seek(&file_, offset);
+		data_.pcmOffset = offset;
+	}
+	int Read(char* buffer, int maxSize)
+	{
+		//ǂݍ݃TCYPCM̈TCYŊ؂ȂȂ玸s
+		if (maxSize % data_.blockSize != 0)
+		{
+			return 0;
+		}
+		//I[𒴂Ȃ悤ɃTCY
+		int readSize = maxSize;
+		if (data_.pcmSize < data_.pcmOffset + readSize / data_.blockSize)
+		{
+			readSize = (data_.pcmSize - data_.pcmOffset) * data_.blockSize;
+		}
+
+		//ov_read_float1pPbgԂȂ̂Ŗ܂܂ŌJԂ
+		//fR[_[floato͂̂܂܎󂯎A16bitƃXeI̕בւSIMDōs
+		int channels = data_.blockSize / 2;
+		int frames = readSize / data_.blockSize;
+		std::int16_t* output = (std::int16_t*)buffer;
+		int decodeFrames = 0;
+		while (decodeFrames < frames)
+		{
+			float** pcm = nullptr;
+			int bitstream = 0;
+			long size = ov_read_float(&file_, &pcm, frames - decodeFrames, &bitstream);
+			if (size == OV_HOLE)
+			{
+				continue;
+			}
+			if (size <= 0)
+			{
+				break;
+			}
+			std::int16_t* dst = output + decodeFrames * channels;
+			if (channels == 1)
+			{
+				SampleConverter::F32ToS16(pcm[0], dst, size);
+			}
+			else
+			{
+				planar_.resize(2 * size);
+				SampleConverter::F32ToS16(pcm[0], planar_.data(), size);
+				SampleConverter::F32ToS16(pcm[1], planar_.data() + size, size);
+				SampleConverter::InterleaveS16(planar_.data(), planar_.data() + size, dst, size);
+			}
+			decodeFrames += (int)size;
+		}
+		data_.pcmOffset += decodeFrames;
+		return decodeFrames * data_.blockSize;
+	}
+
+	int GetPcmOffset() const override
+	{
+		return data_.pcmOffset;
+	}
+
+	int GetLoopStart() const override
+	{
+		return data_.loopStart;
+	}
+
+	int GetLoopLength() const override
+	{
+		return data_.loopLength;
+	}
+
+	int GetPcmSize() const override
+	{
+		return data_.pcmSize;
+	}
+
+	int GetBlockSize() const override
+	{
+		return data_.blockSize;
+	}
+
+	SoundFormat GetFormat() const override
+	{
+		return data_.format;
+	}
+
+	int GetSamplingRate() const override
+	{
+		return data_.samplingRate;
+	}
+private:
+	bool LoadFile(const char* filePass)
+	{
+		if (ov_fopen(filePass, &file_) != 0) {
+			return false;
+		}
+		isOpen_ = true;
+
+		vorbis_info* info = ov_info(&file_, -1);
+		if (info == nullptr || info->channels < 1 || info->channels > 2) {
+			return false;
+		}
+		//fR[hʂ16bit̕tŎ󂯎
+		data_.format = info->channels == 1 ? SoundFormat::Mono16 : SoundFormat::Stereo16;
+		data_.samplingRate = (int)info->rate;
+		data_.blockSize = 2 * info->channels;
+		data_.pcmSize = (int)ov_pcm_total(&file_, -1);
+		data_.dataStartOffset = 0;
+		if (data_.pcmSize <= 0) {
+			return false;
+		}
+
+		//[v|CgRPGcN[ƓLOOPSTART/LOOPLENGTHRg
+		data_.loopStart = 0;
+		data_.loopLength = data_.pcmSize;
+		vorbis_comment* comment = ov_comment(&file_, -1);
+		if (comment != nullptr) {
+			const char* loopStart = vorbis_comment_query(comment, "LOOPSTART", 0);
+			const char* loopLength = vorbis_comment_query(comment, "LOOPLENGTH", 0);
+			if (loopStart != nullptr) {
+				int start = std::atoi(loopStart);
+				if (0 <= start && start < data_.pcmSize) {
+					data_.loopStart = start;
+					data_.loopLength = data_.pcmSize - start;
+				}
+			}
+			if (loopLength != nullptr) {
+				int length = std::atoi(loopLength);
+				if (0 < length && data_.loopStart + length <= data_.pcmSize) {
+					data_.loopLength = length;
+				}
+			}
+		}
+
+		Seek(0);
+		return true;
+	}
+};
+#endif
+
+//SoftwareMixeȑo͂Xg[~O\[Xŗ߂̃f[^
+//I[[vAǂ񂾕̏Ń~bNX (~LT[͎؂邾ŔjȂ)
+class MixerAudioData : public IAudioData
+{
+private:
+	SoftwareMixer* mixer_;
+public:
+	MixerAudioData(SoftwareMixer* mixer) :
+		mixer_(mixer)
+	{}
+	bool LoadFile(const char* filePass) override
+	{
+		(void)filePass;
+		return true;
+	}
+	int Read(char* buffer, int maxSize) override
+	{
+		int frames = maxSize / GetBlockSize();
+		mixer_->Mix((std::int16_t*)buffer, frames);
+		return frames * GetBlockSize();
+	}
+	void Seek(int pcmOffset) override
+	{
+		(void)pcmOffset;
+	}
+	//ʒu͏ɐ擪̂܂܂ɂāA[vI[ɓ͂Ȃ悤ɂ
+	int GetPcmOffset() const override
+	{
+		return 0;
+	}
+	int GetLoopStart() const override
+	{
+		return 0;
+	}
+	int GetLoopLength() const override
+	{
+		return INT_MAX / GetBlockSize();
+	}
+	int GetPcmSize() const override
+	{
+		return INT_MAX / GetBlockSize();
+	}
+	int GetBlockSize() const override
+	{
+		return 4;
+	}
+	SoundFormat GetFormat() const override
+	{
+		return SoundFormat::Stereo16;
+	}
+	int GetSamplingRate() const override
+	{
+		return mixer_->GetSamplingRate();
+	}
+};
+
+//w肳ꂽt@CpX̊gqpēK؂AudioLoader𐶐t@Ng[
+class AudioDataFactory {
+public:
+	enum AudioType {
+		Wave,
+		Ogg,
+		//PackedBank̒1̉
+		Bank,
+		NonSupport,
+	};
+
+private:
+	bool useFileMapping_;
+public:
+	//useFileMappingtrue̎̓}bvłt@CMappedWavDataœǂ
+	AudioDataFactory(bool useFileMapping = true) :
+		useFileMapping_(useFileMapping)
+	{}
+	~AudioDataFactory() = default;
+	IAudioData* Create(const char* filePass)
+	{
+		IAudioData* data=nullptr;
+
+		switch (CheckType(filePass))
+		{
+		case AudioType::Wave:
+			if (useFileMapping_)
+			{
+				//}bvłȂꏊɂt@C͒ʏ̓ǂݍ݂ɐ؂ւ
+				try
+				{
+					data = new MappedWavData(filePass);
+					break;
+				}
+				catch (const std::string&)
+				{
+					data = nullptr;
+				}
+			}
+			data = new WavData(filePass);
+			break;
+		case AudioType::Ogg:
+#if AUDIO_USE_OGG
+			data = new OggData(filePass);
+#endif
+			break;
+
+		case AudioType::Bank:
+			//ĂԓxɃoN}bv̂ŁẢ܂Ƃ߂ēo^鎞SoundClass::LoadPackedBankg
+			{
+				std::string pass(filePass);
+				size_t mark = pass.rfind('#');
+				PackedBank bank;
+				if (bank.Open(pass.substr(0, mark).c_str())) {
+					data = bank.Create(pass.c_str() + mark + 1);
+				}
+			}
+			break;
+
+		case AudioType::NonSupport:
+		default:
+			data = nullptr;
+		}
+
+		return data;
+	}
+private:
+	AudioType CheckType(const char* filePass)
+	{
+		//oN̒̉́uoÑpX#OvŎw肷
+		std::string pass(filePass);
+		size_t mark = pass.rfind('#');
+		if (mark != std::string::npos && CheckFileType(pass.substr(0, mark)) == AudioType::Bank) {
+			return AudioType::Bank;
+		}
+		//oN̂̂1̉ƂĂ͓ǂ߂Ȃ
+		AudioType type = CheckFileType(pass);
+		return type == AudioType::Bank ? AudioType::NonSupport : type;
+	}
+	AudioType CheckFileType(const std::string& filePass)
+	{
+		//gq͍Ṓu.vI[܂ł̕Ƃ (tH_̃hbg͌Ȃ)
+		size_t dot = filePass.find_last_of('.');
+		size_t separator = filePass.find_last_of("/\\");
+		if (dot != std::string::npos && (separator == std::string::npos || dot > separator)) {
+			std::string ext = filePass.substr(dot + 1);
+			if (ext == "ogg") {
+				return AudioType::Ogg;
+			}
+			if (ext == "wav") {
+				return AudioType::Wave;
+			}
+			if (ext == "sbk") {
+				return AudioType::Bank;
+			}
+		}
+
+		//gqŌ܂Ȃΐ擪̐oCgŔf
+		std::ifstream file(filePass, std::ifstream::binary);
+		char magic[12] = {};
+		file.read(magic, sizeof(magic));
+		if (strncmp(magic, "RIFF", 4) == 0 && strncmp(magic + 8, "WAVE", 4) == 0) {
+			return AudioType::Wave;
+		}
+		if (strncmp(magic, "OggS", 4) == 0) {
+			return AudioType::Ogg;
+		}
+		if (PackedBankFormat::IsMagic(magic)) {
+			return AudioType::Bank;
+		}
+		return AudioType::NonSupport;
+	}
+};
+//AllReadœǂݍPCMALobt@t@CpXƃtH[}bgƂɋLLbV
+//t@Cʖŉxo^Ăǂݍ݂alBufferData͍ŏ̈񂾂ɂȂ
+//resampleRatenƓǂݍݎɂ̎g֕ϊĂ (ĐOpenAL̕ϊ𖳂)
+//isCompressȂAL_EXT_IMA4IMA ADPCM̂܂܃obt@ɓ (OpenAL̃1/4ɂȂ)
+//Abv[hOpenALĂ̂ŁA茳ɂPCMt@CcȂ
+class SoundBufferCache
+{
+public:
+	struct Entry
+	{
+		std::string key;
+		ALuint bufferID;
+		//OpenALɓnoCgƁAIMA ADPCMœn
+		int bufferBytes;
+		bool isCompressed;
+		//obt@̒(t[)Ǝg (z{CXĐʒu𐔂̂Ɏg)
+		int frames;
+		int samplingRate;
+		//[v͈ (t[)BAL_SOFT_loop_pointsœnȂ̓obt@S
+		int loopStart;
+		int loopEnd;
+		int refCount;
+		//ʃXbhǂݍݒ̊Ԃtrue
+		bool isLoading;
+		//ǂݍ݂Ɏs (ꗗ͊OĂA҂ĂŌɔj)
+		bool isFailed;
+	};
+	//Prepareœǂݍ݂ƕϊς܂A܂OpenALɓnĂȂf[^
+	//datapcm}bv̈̂ǂ炩w
+	struct Pending
+	{
+		std::string key;
+		std::vector<char> pcm;
+		const char* data;
+		int size;
+		int frames;
+		//t@C̃[v͈͂ϊ̃t[ɂ
+		int loopStart;
+		int loopEnd;
+		ALuint alFormat;
+		int samplingRate;
+		bool isCompressed;
+
+		Pending()
+		{
+			data = nullptr;
+			size = 0;
+			frames = 0;
+			loopStart = 0;
+			loopEnd = 0;
+			alFormat = 0;
+			samplingRate = 0;
+			isCompressed = false;
+		}
+	};
+private:
+	std::mutex mutex_;
+	std::condition_variable loadCv_;
+	std::unordered_map<std::string, Entry*> entries_;
+
+	//ꉞRs[֎~
+	SoundBufferCache(const SoundBufferCache&) = delete;
+	SoundBufferCache& operator=(const SoundBufferCache&) = delete;
+public:
+	SoundBufferCache() = default;
+	~SoundBufferCache()
+	{
+		for (auto& it : entries_)
+		{
+			alDeleteBuffers(1, &it.second->bufferID);
+			delete it.second;
+		}
+		entries_.clear();
+	}
+	//LbVς݂Ȃ炻ԂAaudioSǂŃobt@
+	//audio͂Ŕj (qbgꍇ͂̏ŁAǂ񂾏ꍇ̓Abv[ȟ)
+	//IMA ADPCM͔tȂ̂ŁAisCompress͉풓肽ʉɎg
+	//głOpenALPCMŎȂ̂ŁAkɂ̂܂ܓn
+	Entry* Acquire(const char* filePass, IAudioData* audio, ALuint alFormat, int resampleRate = 0, bool isCompress = false)
+	{
+		std::string key = GetKey(filePass, audio, resampleRate, isCompress);
+
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto it = entries_.find(key);
+		if (it != entries_.end())
+		{
+			delete audio;
+			Entry* entry = it->second;
+			++entry->refCount;
+			//t@CʃXbhǂݍݒȂI܂ő҂
+			loadCv_.wait(lock, [entry] { return !entry->isLoading; });
+			//ǂݍłsAsƂĕԂ
+			if (entry->isFailed)
+			{
+				ReleaseFailed(entry);
+				throw("can't load " + std::string(filePass));
+			}
+			return entry;
+		}
+
+		Entry* entry = new Entry();
+		entry->key = key;
+		entry->refCount = 1;
+		entry->isLoading = true;
+		entry->isFailed = false;
+		entries_.emplace(key, entry);
+		//ǂݍ݂ƃAbv[h̓bNOčsAʃt@C̓ǂݍ݂~߂Ȃ
+		lock.unlock();
+
+		try
+		{
+			Pending pending;
+			Prepare(filePass, audio, alFormat, resampleRate, isCompress, &pending);
+			UploadPending(entry, &pending);
+		}
+		catch (...)
+		{
+			delete audio;
+			lock.lock();
+			Fail(entry);
+			ReleaseFailed(entry);
+			throw;
+		}
+		//OpenALRs[̂ŁA}bvĂt@C͂Ŏ
+		delete audio;
+
+		lock.lock();
+		entry->isLoading = false;
+		loadCv_.notify_all();
+		return entry;
+	}
+	//Prepareœǂ񂾃f[^OpenAL֓năLbVɓ (ReLXg̃XbhŌĂ)
+	//̂ɂΉȂBꂽ͎̂Q0Ȃ̂ŁAɓAcquireŎQƂ邱
+	//pending̎PCM͂ŎAaudio͐GȂ (}bv̈wĂ邱Ƃ̂ŌŔj)
+	void Upload(Pending* pending)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		if (entries_.find(pending->key) != entries_.end())
+		{
+			std::vector<char>().swap(pending->pcm);
+			return;
+		}
+		Entry* entry = new Entry();
+		entry->key = pending->key;
+		entry->refCount = 0;
+		entry->isLoading = true;
+		entry->isFailed = false;
+		entries_.emplace(entry->key, entry);
+		lock.unlock();
+
+		try
+		{
+			UploadPending(entry, pending);
+		}
+		catch (...)
+		{
+			lock.lock();
+			Fail(entry);
+			if (entry->refCount == 0)
+			{
+				delete entry;
+			}
+			throw;
+		}
+
+		lock.lock();
+		entry->isLoading = false;
+		loadCv_.notify_all();
+	}
+	//Uploadœꂽ̂NɂQƂĂȂΏ (UploaďAcquire܂Ői߂ȂɌĂ)
+	void Discard(const std::string& key)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		auto it = entries_.find(key);
+		if (it == entries_.end() || it->second->refCount > 0 || it->second->isLoading)
+		{
+			return;
+		}
+		Entry* entry = it->second;
+		entries_.erase(it);
+		alDeleteBuffers(1, &entry->bufferID);
+		delete entry;
+	}
+	//ɃLbVɂ邩 (Ăǂݍݒ̕ʃXbh邱Ƃ͂)
+	bool Contains(const std::string& key)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.find(key) != entries_.end();
+	}
+	//AcquireƓŃL[ (ǂޑOɋLł邩𒲂ׂ鎞Ɏg)
+	static std::string GetKey(const char* filePass, IAudioData* audio, int resampleRate = 0, bool isCompress = false)
+	{
+		int samplingRate = audio->GetSamplingRate();
+		bool isResample = resampleRate > 0 && resampleRate != samplingRate && Resampler::IsSupported(samplingRate, resampleRate, SoundFormatInfo::GetChannels(audio->GetFormat()));
+		isCompress = isCompress && ALExtension::Get().hasIma4;
+		return MakeKey(filePass, audio->GetFormat(), isResample ? resampleRate : samplingRate, isCompress);
+	}
+	//audioSǂ݁Ag̕ϊIMA ADPCMւ̕܂ōς܂ (OpenALɂ͐GȂ̂łǂ̃XbhłĂׂ)
+	//}bvłf[^̓}bv̈wŃRs[Ȃ̂ŁAAbv[hςނ܂audiojȂ
+	static void Prepare(const char* filePass, IAudioData* audio, ALuint alFormat, int resampleRate, bool isCompress, Pending* pending)
+	{
+		SoundFormat format = audio->GetFormat();
+		int channels = SoundFormatInfo::GetChannels(format);
+		int bits = SoundFormatInfo::GetBits(format);
+		int samplingRate = audio->GetSamplingRate();
+		bool isResample = resampleRate > 0 && resampleRate != samplingRate && Resampler::IsSupported(samplingRate, resampleRate, channels);
+		isCompress = isCompress && ALExtension::Get().hasIma4;
+		pending->key = MakeKey(filePass, format, isResample ? resampleRate : samplingRate, isCompress);
+
+		//[v̑O(Cg)ƌ([X)炷̂Ńt@CŜǂ݁A[v̓Abv[h̎Ƀ[v|Cgœn
+		int size = audio->GetPcmSize() * audio->GetBlockSize();
+		int loopStart = audio->GetLoopStart();
+		int loopEnd = loopStart + audio->GetLoopLength();
+		audio->Seek(0);
+		int readSize = 0;
+		std::vector<char>& pcm = pending->pcm;
+		pcm.clear();
+		const char* data = audio->ReadView(size, &readSize);
+		if (data == nullptr)
+		{
+			pcm.resize(size);
+			readSize = 0;
+			while (readSize != size) {
+				int singleReadSize = audio->Read(pcm.data() + readSize, size - readSize);
+				if (singleReadSize <= 0) {
+					break;
+				}
+				readSize += singleReadSize;
+			}
+			pcm.resize(readSize);
+			data = pcm.data();
+		}
+		//8bitfloat16bitɂȂ
+		if (isResample)
+		{
+			std::vector<char> converted;
+			Resampler::ConvertPcm(data, readSize, channels, bits, samplingRate, resampleRate, &converted);
+			pcm.swap(converted);
+			data = pcm.data();
+			readSize = (int)pcm.size();
+			alFormat = channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+			format = channels == 2 ? SoundFormat::Stereo16 : SoundFormat::Mono16;
+			bits = 16;
+			loopStart = (int)((long long)loopStart * resampleRate / samplingRate);
+			loopEnd = (int)((long long)loopEnd * resampleRate / samplingRate);
+			samplingRate = resampleRate;
+		}
+		int frames = readSize / (channels * bits / 8);
+		//t@CrŐ؂Ă炠镪ɂ
+		loopEnd = std::min(loopEnd, frames);
+		loopStart = std::min(loopStart, loopEnd);
+		//IMA ADPCM16bit畄 (Ō̃ubN̗]͍Ō̃TvŖ܂̂ŁA[v͍ő64TvLт)
+		if (isCompress)
+		{
+			std::vector<std::int16_t> widened;
+			const std::int16_t* source = SoundFormatInfo::ToS16(data, (size_t)frames * channels, format, &widened);
+			std::vector<char> encoded;
+			ImaAdpcm::Encode(source, frames, channels, &encoded);
+			pcm.swap(encoded);
+			data = pcm.data();
+			readSize = (int)pcm.size();
+			alFormat = channels == 2 ? AL_FORMAT_STEREO_IMA4 : AL_FORMAT_MONO_IMA4;
+		}
+		pending->data = data;
+		pending->size = readSize;
+		pending->frames = frames;
+		pending->loopStart = loopStart;
+		pending->loopEnd = loopEnd;
+		pending->alFormat = alFormat;
+		pending->samplingRate = samplingRate;
+		pending->isCompressed = isCompress;
+	}
+	//QƂȂobt@
+	void Release(Entry* entry)
+	{
+		if (entry == nullptr)
+		{
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (--entry->refCount > 0)
+		{
+			return;
+		}
+		entries_.erase(entry->key);
+		alDeleteBuffers(1, &entry->bufferID);
+		delete entry;
+	}
+	//LĂf[^̐
+	size_t GetCount()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return entries_.size();
+	}
+	//OpenALɓnf[^̍voCg (ǂݍݒ̂̂͊܂܂Ȃ)
+	long long GetBufferBytes()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		long long total = 0;
+		for (auto& it : entries_)
+		{
+			if (!it.second->isLoading)
+			{
+				total += it.second->bufferBytes;
+			}
+		}
+		return total;
+	}
+private:
+	//ǂݍݒentryꗗOāA҂Ă鑤N (bNČĂ)
+	//L[Ōォ痈Acquire͐Vǂݒ
+	void Fail(Entry* entry)
+	{
+		entries_.erase(entry->key);
+		entry->isLoading = false;
+		entry->isFailed = true;
+		loadCv_.notify_all();
+	}
+	//sentry̎QƂOAŌ1Ȃj (bNČĂ)
+	void ReleaseFailed(Entry* entry)
+	{
+		if (--entry->refCount == 0)
+		{
+			delete entry;
+		}
+	}
+	//OpenAL󂯕tȂΗO𓊂 (obt@͍ȂƂɂ)
+	void UploadPending(Entry* entry, Pending* pending)
+	{
+		alGetError();
+		alGenBuffers(1, &entry->bufferID);
+		if (alGetError() != AL_NO_ERROR)
+		{
+			throw("can't create buffer " + entry->key);
+		}
+		alBufferData(entry->bufferID, pending->alFormat, pending->data, pending->size, pending->samplingRate);
+		if (alGetError() != AL_NO_ERROR)
+		{
+			alDeleteBuffers(1, &entry->bufferID);
+			throw("can't upload buffer " + entry->key);
+		}
+		entry->bufferBytes = pending->size;
+		entry->isCompressed = pending->isCompressed;
+		entry->frames = pending->frames;
+		entry->samplingRate = pending->samplingRate;
+		entry->loopStart = 0;
+		entry->loopEnd = pending->frames;
+		//[vobt@̈ꕔȂ烋[v|Cgt (AL\[XɕtOɓn)
+		//g̓obt@Ŝ[v
+		bool isPartLoop = pending->loopStart > 0 || pending->loopEnd < pending->frames;
+		if (isPartLoop && pending->loopStart < pending->loopEnd && ALExtension::Get().hasLoopPoints)
+		{
+			ALint points[2] = { pending->loopStart, pending->loopEnd };
+			alBufferiv(entry->bufferID, AL_LOOP_POINTS_SOFT, points);
+			if (alGetError() == AL_NO_ERROR)
+			{
+				entry->loopStart = pending->loopStart;
+				entry->loopEnd = pending->loopEnd;
+			}
+		}
+		//OpenALRs[̂ŁA茳PCM͂Ŏ
+		std::vector<char>().swap(pending->pcm);
+		pending->data = nullptr;
+	}
+	static std::string MakeKey(const char* filePass, SoundFormat format, int samplingRate, bool isCompress)
+	{
+		return std::string(filePass) + "|" + std::to_string((int)format) + "|" + std::to_string(samplingRate) + (isCompress ? "|ima4" : "");
+	}
+};
+//AL_SOFT_events̃obt@Đʒm󂯂āÃ\[X̕[^XNɋN
+//R[obN̓ReLXgɈo^łȂ̂SoundClass
+class BufferEventListener
+{
+private:
+	SoundScheduler* scheduler_;
+	std::mutex mutex_;
+	std::unordered_map<ALuint, SoundScheduler::ITask*> sources_;
+	bool isEnable_;
+
+	//ꉞRs[֎~
+	BufferEventListener(const BufferEventListener&) = delete;
+	BufferEventListener& operator=(const BufferEventListener&) = delete;
+public:
+	BufferEventListener(SoundScheduler* scheduler)
+	{
+		scheduler_ = scheduler;
+		ALExtension& ext = ALExtension::Get();
+		isEnable_ = ext.hasEvents;
+		if (!isEnable_)
+		{
+			return;
+		}
+		const ALenum types[] = { AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT, AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT };
+		ext.alEventCallbackSOFT(&BufferEventListener::Callback, this);
+		ext.alEventControlSOFT(2, types, AL_TRUE);
+	}
+	~BufferEventListener()
+	{
+		if (!isEnable_)
+		{
+			return;
+		}
+		ALExtension& ext = ALExtension::Get();
+		const ALenum types[] = { AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT, AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT };
+		ext.alEventControlSOFT(2, types, AL_FALSE);
+		ext.alEventCallbackSOFT(nullptr, nullptr);
+	}
+	//ggȂfalse (\[X͍Đʒu[vZ)
+	bool IsEnable() const
+	{
+		return isEnable_;
+	}
+	void Register(ALuint sourceID, SoundScheduler::ITask* task)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		sources_[sourceID] = task;
+	}
+	//߂͂̃\[X̃^XNN邱Ƃ͖
+	void Unregister(ALuint sourceID)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		sources_.erase(sourceID);
+	}
+private:
+	//OpenAL̓XbhĂ΂
+	static void AL_APIENTRY Callback(ALenum eventType, ALuint object, ALuint param, ALsizei length, const ALchar* message, void* userParam)
+	{
+		(void)param;
+		(void)length;
+		(void)message;
+		if (eventType != AL_EVENT_TYPE_BUFFER_COMPLETED_SOFT && eventType != AL_EVENT_TYPE_SOURCE_STATE_CHANGED_SOFT)
+		{
+			return;
+		}
+		BufferEventListener* self = static_cast<BufferEventListener*>(userParam);
+		std::lock_guard<std::mutex> lock(self->mutex_);
+		auto it = self->sources_.find(object);
+		if (it != self->sources_.end())
+		{
+			self->scheduler_->Wake(it->second);
+		}
+	}
+};
+//PlayCopypɂ炩ߊmۂĂAL\[X̃v[
+//󂫂̓X^bNAgp͊mۏ̑oXgŎ̂ŊmۂƉO(1)
+//ĐI{CX̓XPW[[܂Ƃ߂ĉ
+class VoicePool : public SoundScheduler::ITask
+{
+public:
+	//t̎ɂǂ̃{CXD
+	enum class StealPolicy {
+		None,		//D킸ɍĐȂ
+		Oldest,		//ԌÂ{CX
+		Quietest,	//ԉʂ̏{CX
+	};
+private:
+	struct Voice
+	{
+		ALuint sourceID;
+		const void* owner;
+		float gain;
+		int prev;
+		int next;
+	};
+	std::mutex mutex_;
+	std::vector<Voice> voices_;
+	std::vector<int> freeList_;
+	//gpXg̐擪ԌÂ
+	int head_;
+	int tail_;
+	int numUsed_;
+	StealPolicy policy_;
+	SoundScheduler* scheduler_;
+
+	//ꉞRs[֎~
+	VoicePool(const VoicePool&) = delete;
+	VoicePool& operator=(const VoicePool&) = delete;
+public:
+	//foCX̃\[XȂΊmۂłœ
+	VoicePool(int numVoice, SoundScheduler* scheduler, StealPolicy policy = StealPolicy::Oldest)
+	{
+		head_ = -1;
+		tail_ = -1;
+		numUsed_ = 0;
+		policy_ = policy;
+		scheduler_ = scheduler;
+
+		alGetError();
+		voices_.reserve(numVoice);
+		for (int i = 0; i < numVoice; ++i)
+		{
+			Voice voice = {};
+			alGenSources(1, &voice.sourceID);
+			if (alGetError() != AL_NO_ERROR)
+			{
+				break;
+			}
+			voice.prev = -1;
+			voice.next = -1;
+			voices_.push_back(voice);
+		}
+		freeList_.reserve(voices_.size());
+		for (int i = (int)voices_.size() - 1; i >= 0; --i)
+		{
+			freeList_.push_back(i);
+		}
+		scheduler_->Add(this);
+	}
+	~VoicePool()
+	{
+		scheduler_->Remove(this);
+		for (auto& voice : voices_)
+		{
+			alSourceStop(voice.sourceID);
+			alDeleteSources(1, &voice.sourceID);
+		}
+	}
+	void SetStealPolicy(StealPolicy policy)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		policy_ = policy;
+	}
+	//{CXbufferĐB󂫂DȂfalse
+	bool Play(const void* owner, ALuint bufferID, float gain)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			int index = -1;
+			if (!freeList_.empty())
+			{
+				index = freeList_.back();
+				freeList_.pop_back();
+			}
+			else
+			{
+				index = FindVictim();
+				if (index < 0)
+				{
+					return false;
+				}
+				alSourceStop(voices_[index].sourceID);
+				Unlink(index);
+			}
+			Voice& voice = voices_[index];
+			voice.owner = owner;
+			voice.gain = gain;
+			alSourcei(voice.sourceID, AL_BUFFER, bufferID);
+			alSourcef(voice.sourceID, AL_MAX_GAIN, gain);
+			alSourcePlay(voice.sourceID);
+			LinkTail(index);
+		}
+		scheduler_->Wake(this);
+		return true;
+	}
+	//owner炵Ă{CXS~߂ĕԂ (\[XOɌĂ)
+	void StopOwner(const void* owner)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (int index = head_; index >= 0;)
+		{
+			int next = voices_[index].next;
+			if (voices_[index].owner == owner)
+			{
+				alSourceStop(voices_[index].sourceID);
+				Release(index);
+			}
+			index = next;
+		}
+	}
+	int GetNumVoice() const
+	{
+		return (int)voices_.size();
+	}
+	int GetNumUsed()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return numUsed_;
+	}
+private:
+	//ĐI{CX󂫂ɖ߂
+	SoundScheduler::Clock::time_point Update(SoundScheduler::Clock::time_point now) override
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		for (int index = head_; index >= 0;)
+		{
+			int next = voices_[index].next;
+			ALint state;
+			alGetSourcei(voices_[index].sourceID, AL_SOURCE_STATE, &state);
+			if (state != AL_PLAYING && state != AL_PAUSED)
+			{
+				Release(index);
+			}
+			index = next;
+		}
+		//gpΎPlay܂ŉȂ
+		if (numUsed_ == 0)
+		{
+			return SoundScheduler::Clock::time_point::max();
+		}
+		//1bɈłsł͂邪AƂ肠60FPS̃EFCg
+		return now + std::chrono::milliseconds(16);
+	}
+	int FindVictim()
+	{
+		switch (policy_)
+		{
+		case StealPolicy::Oldest:
+			return head_;
+		case StealPolicy::Quietest:
+		{
+			int victim = head_;
+			for (int index = head_; index >= 0; index = voices_[index].next)
+			{
+				if (voices_[index].gain < voices_[victim].gain)
+				{
+					victim = index;
+				}
+			}
+			return victim;
+		}
+		case StealPolicy::None:
+		default:
+			return -1;
+		}
+	}
+	void Release(int index)
+	{
+		alSourcei(voices_[index].sourceID, AL_BUFFER, AL_NONE);
+		voices_[index].owner = nullptr;
+		Unlink(index);
+		freeList_.push_back(index);
+	}
+	void LinkTail(int index)
+	{
+		voices_[index].prev = tail_;
+		voices_[index].next = -1;
+		if (tail_ >= 0)
+		{
+			voices_[tail_].next = index;
+		}
+		else
+		{
+			head_ = index;
+		}
+		tail_ = index;
+		++numUsed_;
+	}
+	void Unlink(int index)
+	{
+		Voice& voice = voices_[index];
+		if (voice.prev >= 0)
+		{
+			voices_[voice.prev].next = voice.next;
+		}
+		else
+		{
+			head_ = voice.next;
+		}
+		if (voice.next >= 0)
+		{
+			voices_[voice.next].prev = voice.prev;
+		}
+		else
+		{
+			tail_ = voice.prev;
+		}
+		voice.prev = -1;
+		voice.next = -1;
+		--numUsed_;
+	}
+};
+
+//AllRead̃\[XAL\[XȂz{CXɂāA₷̂ɎۂAL\[X蓖Ă
+//z{CX͍Đʒu(Đn߂~bNXƂ̎̈ʒu)ƉʁEʒuEx̂ŁAĂy
+//~bNX̓foCXۂɕ`悵ԂŁAUpdateŎ󂯎 ([vobNŎԂ葬`悵ĂʒuȂ)
+//UpdateōĐ̃{CX𕷂₷̏ɕׁAʂ̂̂AL\[X蓖Ăč̍Đʒu炷
+//Oꂽ͍̂ĐʒuoAL\[XԂ̂ŁA\[X̐foCX̏𒴂Ă͎Ȃ
+class VirtualVoicePool
+{
+private:
+	enum class State : std::uint8_t {
+		Stopped,
+		Playing,
+		Paused,
+	};
+	//蓖ĒAL\[Xɂ܂nĂȂύX
+	enum Dirty : std::uint8_t {
+		DirtyVolume = 1,
+		DirtyPosition = 2,
+		DirtyVelocity = 4,
+		DirtyLoop = 8,
+		//~߂ĂĐ (Đʒu킹)
+		DirtyOffset = 16,
+	};
+	struct Voice
+	{
+		//Lobt@Ƃ̒(t[)Ǝg (ǂݍ݂I܂ł0)
+		ALuint bufferID;
+		int frames;
+		int samplingRate;
+		//[v͈ (t[)
+		int loopStart;
+		int loopEnd;
+		State state;
+		bool isLoop;
+		bool isUsed;
+		std::uint8_t dirty;
+		//start̃~bNX(b)̎_̍Đʒu (t[)
+		double offset;
+		double start;
+		float volume;
+		float x, y, z;
+		float velocityX, velocityY, velocityZ;
+		//蓖ĂAL\[XrealSources_̓Y (zȂ-1)
+		int real;
+		//ŌɏʂɑI΂ꂽUpdate̔ԍ
+		unsigned selected;
+	};
+	//AL_EXPONENT_DISTANCE̊l (SoundSource͕ςĂȂ)BXi[Ȃ̂Ō_ɂ
+	static constexpr float ReferenceDistance = 1.0f;
+	static constexpr float RolloffFactor = 1.0f;
+	//蓖Ē͕̂̂₷āA炢̂̓mŖt[ւȂ悤ɂ
+	static constexpr float BoundBonus = 1.25f;
+
+	std::mutex mutex_;
+	std::vector<Voice> voices_;
+	std::vector<int> freeList_;
+	std::vector<ALuint> realSources_;
+	//realSources_[i]gĂ{CX (󂫂Ȃ-1)
+	std::vector<int> realOwners_;
+	std::vector<int> freeReals_;
+	//UpdateŎgƗ̈ (₷ƓY)
+	std::vector<std::pair<float, int>> ranking_;
+	unsigned frame_;
+	//ŌUpdateŎ󂯎~bNX (b)
+	double now_;
+	int numPlaying_;
+	long long numBind_;
+
+	//ꉞRs[֎~
+	VirtualVoicePool(const VirtualVoicePool&) = delete;
+	VirtualVoicePool& operator=(const VirtualVoicePool&) = delete;
+public:
+	//foCX̃\[XȂΊmۂłœ
+	VirtualVoicePool(int numRealVoice)
+	{
+		frame_ = 0;
+		now_ = 0.0;
+		numPlaying_ = 0;
+		numBind_ = 0;
+		alGetError();
+		realSources_.reserve(numRealVoice);
+		for (int i = 0; i < numRealVoice; ++i)
+		{
+			ALuint sourceID = 0;
+			alGenSources(1, &sourceID);
+			if (alGetError() != AL_NO_ERROR)
+			{
+				break;
+			}
+			realSources_.push_back(sourceID);
+		}
+		realOwners_.assign(realSources_.size(), -1);
+		for (int i = (int)realSources_.size() - 1; i >= 0; --i)
+		{
+			freeReals_.push_back(i);
+		}
+	}
+	~VirtualVoicePool()
+	{
+		for (ALuint sourceID : realSources_)
+		{
+			alSourceStop(sourceID);
+			alDeleteSources(1, &sourceID);
+		}
+	}
+	//{CXēYԂBǂݍ݂ISetBufferĂԂ
+	int Add()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		int index;
+		if (!freeList_.empty())
+		{
+			index = freeList_.back();
+			freeList_.pop_back();
+		}
+		else
+		{
+			index = (int)voices_.size();
+			voices_.emplace_back();
+		}
+		Voice& voice = voices_[index];
+		voice = Voice();
+		voice.state = State::Stopped;
+		voice.isUsed = true;
+		voice.volume = 1.0f;
+		voice.real = -1;
+		return index;
+	}
+	//AL\[X蓖ĂĂΎ~߂ĕԂ (Lobt@OɌĂ)
+	void Remove(int index)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		if (voice.real >= 0)
+		{
+			Unbind(index, now_);
+		}
+		voice.isUsed = false;
+		voice.bufferID = 0;
+		freeList_.push_back(index);
+	}
+	//ǂݍ݂̑OɍĐĂ̂́A玞Ԃ𐔂n߂
+	//[v̓obt@ɕt[v|CgƓ͈͂n
+	void SetBuffer(int index, ALuint bufferID, int frames, int samplingRate, int loopStart, int loopEnd)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		voice.bufferID = bufferID;
+		voice.frames = frames;
+		voice.samplingRate = samplingRate;
+		voice.loopStart = loopStart;
+		voice.loopEnd = loopStart < loopEnd ? loopEnd : frames;
+		voice.start = now_;
+	}
+	//ĐȂ牽Ȃ (AL\[XƓ)Bꎞ~Ȃ瑱A~Ȃ擪炷
+	void Play(int index, bool loop)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		double now = now_;
+		if (voice.isLoop != loop)
+		{
+			voice.isLoop = loop;
+			voice.dirty |= DirtyLoop;
+		}
+		if (voice.state == State::Playing && IsAlive(voice, now))
+		{
+			return;
+		}
+		if (voice.state != State::Paused)
+		{
+			voice.offset = 0.0;
+		}
+		voice.state = State::Playing;
+		voice.start = now;
+		voice.dirty |= DirtyOffset;
+	}
+	void Pause(int index)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		if (voice.state == State::Playing)
+		{
+			voice.offset = GetOffset(voice, now_);
+			voice.state = State::Paused;
+		}
+	}
+	void Stop(int index)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		voice.state = State::Stopped;
+		voice.offset = 0.0;
+	}
+	void SetVolume(int index, float volume)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		voices_[index].volume = volume;
+		voices_[index].dirty |= DirtyVolume;
+	}
+	void SetPosition(int index, float x, float y, float z)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		voice.x = x;
+		voice.y = y;
+		voice.z = z;
+		voice.dirty |= DirtyPosition;
+	}
+	void SetVelocity(int index, float x, float y, float z)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		Voice& voice = voices_[index];
+		voice.velocityX = x;
+		voice.velocityY = y;
+		voice.velocityZ = z;
+		voice.dirty |= DirtyVelocity;
+	}
+	//[vȂ̂͏I[܂ōĐ_falseɂȂ (AL\[X蓖ĂĂȂĂ)
+	bool IsPlaying(int index)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		const Voice& voice = voices_[index];
+		return voice.state == State::Playing && IsAlive(voice, now_);
+	}
+	//t[xĂԁB₷ɏʂ̃{CXAL\[X蓖ĒA蓖ĂĂ{CX̐Ԃ
+	//mixedTime̓foCX`悵(b)ŁA蓖ĂĂȂ{CX̍Đʒu͂Ői߂
+	//ύXAL_SOFT_deferred_updates(alcSuspendContext)̒ł܂Ƃ߂ēn
+	int Update(ALCcontext* context, double mixedTime)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		//foCXJĎv߂ĂAĐʒu͊߂Ȃ
+		now_ = std::max(now_, mixedTime);
+		double now = now_;
+		ALExtension& ext = ALExtension::Get();
+		if (ext.hasDeferredUpdates)
+		{
+			ext.alDeferUpdatesSOFT();
+		}
+		else
+		{
+			alcSuspendContext(context);
+		}
+		//ÎƁA~߂ꂽ̂AL\[XԂ
+		for (int real = 0; real < (int)realSources_.size(); ++real)
+		{
+			int index = realOwners_[real];
+			if (index < 0)
+			{
+				continue;
+			}
+			Voice& voice = voices_[index];
+			if (voice.state == State::Playing && !(voice.dirty & DirtyOffset))
+			{
+				ALint state;
+				alGetSourcei(realSources_[real], AL_SOURCE_STATE, &state);
+				if (state == AL_STOPPED)
+				{
+					voice.state = State::Stopped;
+					voice.offset = 0.0;
+				}
+			}
+			if (voice.state != State::Playing)
+			{
+				Unbind(index, now);
+			}
+		}
+
+		//Đ̂̂𕷂₷ŕׁAʂI (Ȃ̂ɂ͊蓖ĂȂ)
+		ranking_.clear();
+		for (int index = 0; index < (int)voices_.size(); ++index)
+		{
+			Voice& voice = voices_[index];
+			if (!voice.isUsed || voice.state != State::Playing || voice.frames <= 0)
+			{
+				continue;
+			}
+			if (voice.real < 0 && !IsAlive(voice, now))
+			{
+				voice.state = State::Stopped;
+				voice.offset = 0.0;
+				continue;
+			}
+			float audibility = GetAudibility(voice);
+			if (audibility <= 0.0f)
+			{
+				continue;
+			}
+			ranking_.push_back({ voice.real >= 0 ? audibility * BoundBonus : audibility, index });
+		}
+		numPlaying_ = (int)ranking_.size();
+		if (ranking_.size() > realSources_.size())
+		{
+			std::nth_element(ranking_.begin(), ranking_.begin() + realSources_.size(), ranking_.end(),
+				[](const std::pair<float, int>& a, const std::pair<float, int>& b) { return a.first > b.first; });
+			ranking_.resize(realSources_.size());
+		}
+		++frame_;
+		for (const auto& rank : ranking_)
+		{
+			voices_[rank.second].selected = frame_;
+		}
+
+		//Oꂽ̂ɕԂĂAVI΂ꂽ̂Ɋ蓖Ă
+		for (int real = 0; real < (int)realSources_.size(); ++real)
+		{
+			int index = realOwners_[real];
+			if (index >= 0 && voices_[index].selected != frame_)
+			{
+				Unbind(index, now);
+			}
+		}
+		int numBound = 0;
+		for (const auto& rank : ranking_)
+		{
+			Voice& voice = voices_[rank.second];
+			if (voice.real < 0)
+			{
+				Bind(rank.second, now);
+			}
+			else if (voice.dirty != 0)
+			{
+				Apply(voice, now);
+			}
+			++numBound;
+		}
+
+		if (ext.hasDeferredUpdates)
+		{
+			ext.alProcessUpdatesSOFT();
+		}
+		else
+		{
+			alcProcessContext(context);
+		}
+		return numBound;
+	}
+	//mۂłAL\[X̐
+	int GetNumRealVoice() const
+	{
+		return (int)realSources_.size();
+	}
+	//OUpdateōĐ{CX̐ (蓖ĂĂȂ̂܂)
+	int GetNumPlaying()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return numPlaying_;
+	}
+	//AL\[X蓖Ă݌v (t[傫Ȃւ肪)
+	long long GetNumBind()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return numBind_;
+	}
+private:
+	//now̎_̍Đʒu ([v̂̓[vI[zJnʒu֊߂AȂ̂͏I[Ŏ~߂)
+	static double GetOffset(const Voice& voice, double now)
+	{
+		if (voice.state != State::Playing || voice.frames <= 0)
+		{
+			return voice.offset;
+		}
+		double offset = voice.offset + (now - voice.start) * voice.samplingRate;
+		if (voice.isLoop && offset >= voice.loopEnd)
+		{
+			return voice.loopStart + std::fmod(offset - voice.loopStart, (double)(voice.loopEnd - voice.loopStart));
+		}
+		return std::min(offset, (double)voice.frames);
+	}
+	//ǂݍݒA܂I[ɒBĂȂ
+	static bool IsAlive(const Voice& voice, double now)
+	{
+		return voice.frames <= 0 || voice.isLoop || GetOffset(voice, now) < voice.frames;
+	}
+	//AL_EXPONENT_DISTANCEł̋ƁAAL_MAX_GAINɓnĂ鉹ʂ̏
+	static float GetAudibility(const Voice& voice)
+	{
+		float distance2 = voice.x * voice.x + voice.y * voice.y + voice.z * voice.z;
+		if (distance2 <= 0.0f)
+		{
+			return voice.volume;
+		}
+		float attenuation = std::pow(distance2 / (ReferenceDistance * ReferenceDistance), -RolloffFactor * 0.5f);
+		return std::min(voice.volume, attenuation);
+	}
+	void Bind(int index, double now)
+	{
+		if (freeReals_.empty())
+		{
+			return;
+		}
+		int real = freeReals_.back();
+		freeReals_.pop_back();
+		realOwners_[real] = index;
+		Voice& voice = voices_[index];
+		voice.real = real;
+		voice.offset = GetOffset(voice, now);
+		voice.start = now;
+		voice.dirty = 0;
+		ALuint sourceID = realSources_[real];
+		alSourcei(sourceID, AL_BUFFER, voice.bufferID);
+		alSourcei(sourceID, AL_LOOPING, voice.isLoop ? AL_TRUE : AL_FALSE);
+		alSourcef(sourceID, AL_MAX_GAIN, voice.volume);
+		alSource3f(sourceID, AL_POSITION, voice.x, voice.y, voice.z);
+		alSource3f(sourceID, AL_VELOCITY, voice.velocityX, voice.velocityY, voice.velocityZ);
+		alSourcei(sourceID, AL_SAMPLE_OFFSET, (ALint)voice.offset);
+		alSourcePlay(sourceID);
+		++numBind_;
+	}
+	//Đ̂܂܊OAL\[X̍ĐʒuoĂAɊ蓖Ăɂ炷
+	void Unbind(int index, double now)
+	{
+		Voice& voice = voices_[index];
+		ALuint sourceID = realSources_[voice.real];
+		if (voice.state == State::Playing && !(voice.dirty & DirtyOffset))
+		{
+			ALint offset = 0;
+			alGetSourcei(sourceID, AL_SAMPLE_OFFSET, &offset);
+			voice.offset = offset;
+			voice.start = now;
+		}
+		alSourceStop(sourceID);
+		alSourcei(sourceID, AL_BUFFER, AL_NONE);
+		realOwners_[voice.real] = -1;
+		freeReals_.push_back(voice.real);
+		voice.real = -1;
+		//蓖ĒɑSn̂ŁAcĂύX͎̂ĂĂ悢
+		voice.dirty = 0;
+	}
+	//蓖ĒAL\[XɕύXn
+	void Apply(Voice& voice, double now)
+	{
+		ALuint sourceID = realSources_[voice.real];
+		if (voice.dirty & DirtyLoop)
+		{
+			alSourcei(sourceID, AL_LOOPING, voice.isLoop ? AL_TRUE : AL_FALSE);
+		}
+		if (voice.dirty & DirtyVolume)
+		{
+			alSourcef(sourceID, AL_MAX_GAIN, voice.volume);
+		}
+		if (voice.dirty & DirtyPosition)
+		{
+			alSource3f(sourceID, AL_POSITION, voice.x, voice.y, voice.z);
+		}
+		if (voice.dirty & DirtyVelocity)
+		{
+			alSource3f(sourceID, AL_VELOCITY, voice.velocityX, voice.velocityY, voice.velocityZ);
+		}
+		if (voice.dirty & DirtyOffset)
+		{
+			voice.offset = GetOffset(voice, now);
+			voice.start = now;
+			alSourceStop(sourceID);
+			alSourcei(sourceID, AL_SAMPLE_OFFSET, (ALint)voice.offset);
+			alSourcePlay(sourceID);
+		}
+		voice.dirty = 0;
+	}
+};
+
+//SoundClassĂđS\[XŋL
+//nullptr̂̂̓\[XOŗpӂ (eventsvirtualVoices͖ΎgȂ)
+struct SoundEnvironment
+{
+	SoundBufferCache* cache;
+	SoundScheduler* scheduler;
+	BufferEventListener* events;
+	VoicePool* voices;
+	//e\[X̃JE^[ɂ (nullptrȂWvȂ)
+	SoundStats* stats;
+	//Xg[~O̐ǂ݂s
+	WorkerPool* io;
+	//AllRead̃\[XAL\[XȂz{CXɂ
+	VirtualVoicePool* virtualVoices;
+	//0ȊOȂAllReadPCMǂݍݎɂ̎g(foCX̎g)֕ϊ
+	int resampleRate;
+	//AllRead̃obt@IMA ADPCMŎ (AL_EXT_IMA4PCM̂܂)
+	bool isCompress;
+};
+
+//Xg[~Õobt@̎
+struct StreamingConfig
+{
+	//L[ɐςރobt@ (K[hł͏l)
+	int numBuffer;
+	//obt@1̒ (~b)BgtH[}bgɊ֌WȂԕǂ
+	int bufferMs;
+	//A_[obt@𑝂₵A]T̂Ԃ猸炷
+	//(x邩A\[X̃邩sɒ)
+	bool isAdaptive;
+	//K[hő͈
+	int minBuffer;
+	int maxBuffer;
+	//Ƀt@Cǂłobt@B0ȂXPW[[̃Xbhŕ[̓xɓǂ
+	//(ǂݍ݂̒xLłI/Ȏ҂̂܂ܕ[̒xɂȂ)
+	int prefetchDepth;
+	//environmentresampleRateւ̕ϊXg[~Ołs ([̓xɕϊ̂CPUg)
+	bool isResample;
+
+	//]ʂobt@nĂg悤ɂĂ
+	StreamingConfig(int numBuffer = 32, int bufferMs = 25, bool isAdaptive = false)
+	{
+		this->numBuffer = numBuffer;
+		this->bufferMs = bufferMs;
+		this->isAdaptive = isAdaptive;
+		minBuffer = 4;
+		maxBuffer = 128;
+		prefetchDepth = 8;
+		isResample = false;
+	}
+};
+
+class SoundSource : public SoundScheduler::ITask
+{
+public:
+	enum LoadMode {
+		Streaming,
+		AllRead,
+	};
+	enum class LoadState {
+		Loading,
+		Ready,
+		Failed,
+	};
+private:
+	const std::string name_;
+	const std::string filePass_;
+	IAudioData* audio_;
+	LoadMode mode_;
+	//AllReadPCMƃobt@͓t@C̃\[XmŋL
+	SoundBufferCache* cache_;
+	SoundBufferCache* ownCache_;
+	//PlayCopy̓v[̃{CXŖ炷
+	VoicePool* voices_;
+	VoicePool* ownVoices_;
+	SoundBufferCache::Entry* shared_;
+	//z{CXɂAllRead̃\[XAL\[XAĐ̓R}hς܂ɂ֒ړn
+	VirtualVoicePool* virtualVoices_;
+	int virtualIndex_;
+	//obt@[ƃRs[Đ̌Еt̓XPW[[̃Xbhōs
+	SoundScheduler* scheduler_;
+	SoundScheduler* ownScheduler_;
+	//g鎞̓obt@Đ̒ʒmŕ[
+	BufferEventListener* events_;
+	//Xg[~OI/ÕXbhŐǂ݂ĂA[̎̓ORs[邾ɂ
+	PrefetchRing* prefetch_;
+	WorkerPool* io_;
+	WorkerPool* ownIo_;
+	//ǂ݂Ԃɍ킸ɕ[łȂ (I/Ol߂Wake)
+	std::atomic<bool> isStarved_;
+	//Ōɐς񂾃obt@[vI[ŏIĂ
+	//[vȂȂ炻ȏ͐ς܂AIĎ~܂ƂŒ~ɂ
+	bool isStreamEnd_;
+	//ϊ̎g (0ȂϊȂ)
+	int resampleRate_;
+	//AllRead̃obt@IMA ADPCMŎ
+	bool isCompress_;
+	//Xg[~Oŕϊ鎞ɁA̎gœǂނ߂̗̈ƕϊ (ǂޑ̃XbhG)
+	Resampler* resampler_;
+	std::vector<char> resampleInput_;
+	std::vector<std::int16_t> widened_;
+	//ALobt@ɓnf[^̎gƃt[̃oCg (ϊȂaudio_Ɠ)
+	int alRate_;
+	int alBlockSize_;
+
+	//Đ͂̃L[ɐςłAXPW[[̃XbhUpdate̍ŏɎs
+	//ԂɈӖ̂ς݁AʁEʒuEx͍ŐV̒lƈ󂾂 (t[Ă΂Ă܂Ȃ)
+	enum class CommandType {
+		Play,
+		PlayCopy,
+		Pause,
+		Stop,
+	};
+	struct Command {
+		CommandType type;
+		bool loop;
+	};
+	CommandRing<Command, 64> commands_;
+	//Ot̎ɐςޏBɎcĂԂ͌ォ痈̂ɐςŏԂۂ
+	std::mutex overflowMutex_;
+	std::vector<Command> overflow_;
+	std::atomic<bool> hasOverflow_;
+	//܂ALɓnĂȂʁEʒuEx
+	enum Dirty : std::uint8_t {
+		DirtyVolume = 1,
+		DirtyPosition = 2,
+		DirtyVelocity = 4,
+	};
+	std::atomic<std::uint8_t> dirty_;
+
+	ALuint sourceID_;
+	//Xg[~Opobt@ (K[hł͍ő吔̗̈A擪numGenerated_L)
+	ALuint *bufferIDs_;
+	int numGenerated_;
+	int capacity_;
+	//L[ɐςłobt@ (K[hł͎sɕς)
+	std::atomic<int> numBuffer_;
+	StreamingConfig config_;
+	//obt@1̃oCg (config_.bufferMsǂݍݎɌ߂)
+	int bufferBytes_;
+	std::vector<char> readBuffer_;
+	//炵ɊOobt@B₷͂g
+	std::vector<ALuint> spareBuffers_;
+	//K[hŌ炷𔻒f邽߂́AO̔f̕[Ǝcobt@̍ŏl
+	int healthyRefills_;
+	int minPending_;
+
+	ALuint format_;
+
+	//PlayCopyŎgBSoundClassFlushUpdatesʂ̃Xbh珑
+	//SetPositionȂǂ͌Ă񂾃XbhŏAXPW[[̃Xbhdirty_ALɓn
+	std::atomic<float> volume_;
+	std::atomic<float> posX_, posY_, posZ_;
+	std::atomic<float> velocityX_, velocityY_, velocityZ_;
+
+	//ĂяoƃXPW[[̃Xbh̗ĜŃAg~bNɂ
+	std::atomic<bool> isPlayed_;
+	std::atomic<bool> isLoop_;
+	std::atomic<bool> isEnd_;
+	//񓯊ǂݍ݂̏ (j鎞͓ǂݍ݂Î҂)
+	std::atomic<LoadState> loadState_;
+	//CreateSourceAsyncŐς񂾓ǂݍ݂̏
+	//n܂OɔjꂽA\[X̔j͓ǂݍݑɔC (Abandoned)
+	enum class LoadJob : int
+	{
+		None,
+		Queued,
+		Started,
+		Abandoned,
+	};
+	std::atomic<LoadJob> loadJob_;
+	//A_[L[̎c̃JE^[
+	SoundStats stats_;
+	std::mutex loadMutex_;
+	std::condition_variable loadCv_;
+public:
+	//environmentȗꍇ(܂͒gnullptȑꍇ)͂̃\[Xp̂̂
+	//isDeferredtrue͓̎ǂݍ܂ɕԂ̂ŁALoad(ʃXbhł)ĂԂ
+	SoundSource(const char* filePass, LoadMode mode, const StreamingConfig& config = StreamingConfig(), const SoundEnvironment* environment = nullptr, bool isDeferred = false) :
+		filePass_(filePass), config_(config)
+	{
+		SoundEnvironment env = {};
+		if (environment != nullptr)
+		{
+			env = *environment;
+		}
+		audio_ = nullptr;
+		sourceID_ = 0;
+		//Xg[~O͍Œł2ȂƓr؂
+		config_.numBuffer = std::max(2, config_.numBuffer);
+		config_.bufferMs = std::max(1, config_.bufferMs);
+		config_.prefetchDepth = std::max(0, config_.prefetchDepth);
+		if (config_.isAdaptive)
+		{
+			config_.minBuffer = std::max(2, config_.minBuffer);
+			config_.maxBuffer = std::max(config_.minBuffer, config_.maxBuffer);
+			config_.numBuffer = std::min(std::max(config_.numBuffer, config_.minBuffer), config_.maxBuffer);
+		}
+		capacity_ = config_.isAdaptive ? config_.maxBuffer : config_.numBuffer;
+		bufferIDs_ = new ALuint[capacity_]();
+		numGenerated_ = 0;
+		bufferBytes_ = 0;
+		healthyRefills_ = 0;
+		minPending_ = INT_MAX;
+		ownScheduler_ = nullptr;
+		if (env.scheduler == nullptr)
+		{
+			ownScheduler_ = new SoundScheduler();
+			env.scheduler = ownScheduler_;
+		}
+		scheduler_ = env.scheduler;
+		events_ = env.events;
+		stats_.SetParent(env.stats);
+		prefetch_ = nullptr;
+		ownIo_ = nullptr;
+		if (mode == LoadMode::Streaming && config_.prefetchDepth > 0 && env.io == nullptr)
+		{
+			ownIo_ = new WorkerPool(1);
+			env.io = ownIo_;
+		}
+		io_ = env.io;
+		isStarved_ = false;
+		isStreamEnd_ = false;
+		resampleRate_ = env.resampleRate;
+		isCompress_ = env.isCompress;
+		resampler_ = nullptr;
+		alRate_ = 0;
+		alBlockSize_ = 0;
+		ownCache_ = nullptr;
+		ownVoices_ = nullptr;
+		if (mode == LoadMode::AllRead)
+		{
+			if (env.cache == nullptr)
+			{
+				ownCache_ = new SoundBufferCache();
+				env.cache = ownCache_;
+			}
+			if (env.voices == nullptr)
+			{
+				ownVoices_ = new VoicePool(8, scheduler_);
+				env.voices = ownVoices_;
+			}
+		}
+		cache_ = env.cache;
+		voices_ = env.voices;
+		shared_ = nullptr;
+		virtualVoices_ = nullptr;
+		virtualIndex_ = -1;
+		if (mode == LoadMode::AllRead && env.virtualVoices != nullptr)
+		{
+			virtualVoices_ = env.virtualVoices;
+			virtualIndex_ = virtualVoices_->Add();
+		}
+		isPlayed_ = false;
+		isLoop_ = false;
+		isEnd_ = false;
+		loadState_ = LoadState::Loading;
+		loadJob_ = LoadJob::None;
+		numBuffer_ = config_.numBuffer;
+		mode_ = mode;
+		volume_ = 1.0f;
+		posX_ = posY_ = posZ_ = 0.0f;
+		velocityX_ = velocityY_ = velocityZ_ = 0.0f;
+		dirty_ = 0;
+		hasOverflow_ = false;
+
+		if (isDeferred)
+		{
+			return;
+		}
+		//ǂݍ݂͎s獡܂ŒʂOŕԂ
+		try
+		{
+			Load();
+		}
+		catch (...)
+		{
+			Release();
+			throw;
+		}
+	}
+	//t@C̑audio𗬂Xg[~O\[X (audiȍL̓\[XɈڂ)
+	//SoftwareMixeȑo͂炷ȂǂɎg
+	SoundSource(IAudioData* audio, const StreamingConfig& config = StreamingConfig(), const SoundEnvironment* environment = nullptr) :
+		SoundSource("", LoadMode::Streaming, config, environment, true)
+	{
+		audio_ = audio;
+		Load();
+	}
+	~SoundSource()
+	{
+		//œǂݍݒȂ炻ꂪÎ҂
+		{
+			std::unique_lock<std::mutex> lock(loadMutex_);
+			isEnd_ = true;
+			loadCv_.wait(lock, [this] { return loadState_ != LoadState::Loading; });
+		}
+		Release();
+	}
+	//t@CJăobt@AĐłԂɂ
+	//s͗O𓊂 (LoadStateFailedɂȂ)
+	void Load()
+	{
+		//LZς݂Ȃ牽Ȃ
+		if (isEnd_)
+		{
+			FinishLoad(LoadState::Failed);
+			return;
+		}
+		try
+		{
+			LoadAudio();
+		}
+		catch (...)
+		{
+			FinishLoad(LoadState::Failed);
+			throw;
+		}
+		//ǂݍݑOɐς܂ꂽ̓XPW[[ɓo^Ă珉߂Ďs
+		FinishLoad(LoadState::Ready);
+	}
+	//isDeferredō\[X̓ǂݍ݂loaderɐςޑOɌĂ
+	void QueueLoad()
+	{
+		loadJob_ = LoadJob::Queued;
+	}
+	//ς񂾓ǂݍ݂܂n܂ĂȂ΁AjɔCtrueԂ (ȍ~thisɐGȂ)
+	//falseȂ獡܂Œʂdelete (ǂݍݒȂ炻ꂪÎ҂)
+	bool AbandonLoad()
+	{
+		LoadJob expected = LoadJob::Queued;
+		return loadJob_.compare_exchange_strong(expected, LoadJob::Abandoned);
+	}
+	//loader̃XbhŐς񂾓ǂݍ݂sAۂԂ
+	//AbandonLoadĂǂ܂sourcefalseԂ
+	static bool RunQueuedLoad(SoundSource* source)
+	{
+		LoadJob expected = LoadJob::Queued;
+		if (!source->loadJob_.compare_exchange_strong(expected, LoadJob::Started))
+		{
+			source->FinishLoad(LoadState::Failed);
+			delete source;
+			return false;
+		}
+		try
+		{
+			source->Load();
+		}
+		catch (...)
+		{
+			return false;
+		}
+		return true;
+	}
+	//ʂ̃XbhŊJĂaudioœǂݍ (audiȍL̓\[XɈڂ)
+	//isDeferredō\[XɎgBAllReadœf[^LbVɂ΃t@C͓ǂ܂Ȃ
+	void Load(IAudioData* audio)
+	{
+		delete audio_;
+		audio_ = audio;
+		Load();
+	}
+	//ȉ̑̓R}hςŃXPW[[̃XbhɔĈŌĂяo͑҂Ȃ
+	void Play(bool loop)
+	{
+		isPlayed_ = true;
+		if (virtualVoices_ != nullptr)
+		{
+			isLoop_ = loop;
+			virtualVoices_->Play(virtualIndex_, loop);
+			return;
+		}
+		PushCommand({ CommandType::Play, loop });
+	}
+	void PlayCopy()
+	{
+		//Xg[~O[hł͗płȂ
+		if (mode_ == LoadMode::Streaming) 
+		{
+			return;
+		}
+		isPlayed_ = true;
+		PushCommand({ CommandType::PlayCopy, false });
+	}
+	void Pause()
+	{
+		isPlayed_ = false;
+		if (virtualVoices_ != nullptr)
+		{
+			virtualVoices_->Pause(virtualIndex_);
+			return;
+		}
+		PushCommand({ CommandType::Pause, false });
+	}
+
+	void Stop()
+	{
+		isPlayed_ = false;
+		if (virtualVoices_ != nullptr)
+		{
+			virtualVoices_->Stop(virtualIndex_);
+			return;
+		}
+		PushCommand({ CommandType::Stop, false });
+	}
+	void SetVolume(float volume)
+	{
+		if (virtualVoices_ != nullptr)
+		{
+			ApplyVolume(volume);
+			return;
+		}
+		volume_ = volume;
+		MarkDirty(DirtyVolume);
+	}
+	void SetPosition(float x, float y, float z)
+	{
+		if (virtualVoices_ != nullptr)
+		{
+			ApplyPosition(x, y, z);
+			return;
+		}
+		posX_ = x;
+		posY_ = y;
+		posZ_ = z;
+		MarkDirty(DirtyPosition);
+	}
+	void SetVelocity(float x, float y, float z)
+	{
+		if (virtualVoices_ != nullptr)
+		{
+			ApplyVelocity(x, y, z);
+			return;
+		}
+		velocityX_ = x;
+		velocityY_ = y;
+		velocityZ_ = z;
+		MarkDirty(DirtyVelocity);
+	}
+	//z{CX̓[vȂ̂I[܂Ŗ炵IfalseɂȂ
+	bool IsPlay()
+	{
+		if (virtualVoices_ != nullptr)
+		{
+			return virtualVoices_->IsPlaying(virtualIndex_);
+		}
+		return isPlayed_;
+	}
+	//AL\[XȂz{CX (GetSourceID0Ԃ)
+	bool IsVirtual() const
+	{
+		return virtualVoices_ != nullptr;
+	}
+	//ǂݍݒ(Loading)̊ԂɌĂ񂾍Đ͐ςłAǂݍ݂Is
+	LoadState GetLoadState() const
+	{
+		return loadState_;
+	}
+	bool IsReady() const
+	{
+		return loadState_ == LoadState::Ready;
+	}
+	//L[ɐςłobt@ (K[hł͍̒l)
+	int GetNumBuffer() const
+	{
+		return numBuffer_;
+	}
+	//obt@1̒ (~b)
+	int GetBufferMs() const
+	{
+		return config_.bufferMs;
+	}
+	//ǂ݃Oɗ܂Ăobt@ (ǂ݂ĂȂ0)
+	int GetPrefetchOccupancy() const
+	{
+		if (loadState_ != LoadState::Ready || prefetch_ == nullptr)
+		{
+			return 0;
+		}
+		return prefetch_->GetNumReady();
+	}
+	//Xg[~ǑS̃JE^[ (ǂ̃XbhłbNœǂ߂)
+	SoundStats::Snapshot GetStats() const
+	{
+		return stats_.GetSnapshot();
+	}
+	//vȌԊmFp (̓R}hoRōsƁBz{CXȂ0)
+	ALuint GetSourceID() const
+	{
+		return sourceID_;
+	}
+	//8bitOpenAL8bitŎ󂯎̂ł̂܂ܓn
+	//floatAL_EXT_FLOAT32鎞Ȃ̂ŁÂ܂ܓnĂ悢
+	//(SoundClass::LoadBankLbVɐɓ鎞lg)
+	static ALenum ToALFormat(SoundFormat format)
+	{
+		switch (format) {
+		case SoundFormat::Mono8: return AL_FORMAT_MONO8;
+		case SoundFormat::Stereo8: return AL_FORMAT_STEREO8;
+		case SoundFormat::Stereo16: return AL_FORMAT_STEREO16;
+		case SoundFormat::MonoFloat32: return AL_FORMAT_MONO_FLOAT32;
+		case SoundFormat::StereoFloat32: return AL_FORMAT_STEREO_FLOAT32;
+		default: return AL_FORMAT_MONO16;
+		}
+	}
+	//SourceUpdateBatchĂԁBR}hς܂ɁAĂ񂾃Xbhł̂܂ALɓn
+	//(ǂݍ݂IO͌Ă΂ȂƁBSetVolumeȂǂƓ\[XōƁAǂ炪Ɍ͌܂Ȃ)
+	//z{CX͒lo邾ŁAAL\[X蓖ĂĂ鎞VirtualVoicePool::Updaten
+	void ApplyVolume(float volume)
+	{
+		volume_ = volume;
+		if (virtualVoices_ != nullptr)
+		{
+			virtualVoices_->SetVolume(virtualIndex_, volume);
+			return;
+		}
+		alSourcef(sourceID_, AL_MAX_GAIN, volume);
+	}
+	void ApplyPosition(float x, float y, float z)
+	{
+		if (virtualVoices_ != nullptr)
+		{
+			virtualVoices_->SetPosition(virtualIndex_, x, y, z);
+			return;
+		}
+		alSource3f(sourceID_, AL_POSITION, x, y, z);
+	}
+	void ApplyVelocity(float x, float y, float z)
+	{
+		if (virtualVoices_ != nullptr)
+		{
+			virtualVoices_->SetVelocity(virtualIndex_, x, y, z);
+			return;
+		}
+		alSource3f(sourceID_, AL_VELOCITY, x, y, z);
+	}
+
+private:
+	//XPW[[Ă΂BĐȂ珈ς݃obt@[Ď̕[Ԃ
+	SoundScheduler::Clock::time_point Update(SoundScheduler::Clock::time_point now) override
+	{
+		if (isEnd_ || loadState_ != LoadState::Ready) {
+			return SoundScheduler::Clock::time_point::max();
+		}
+		ExecuteCommands();
+		//Rs[Đ̌Еt̓{CXv[s
+		if (mode_ == LoadMode::AllRead) {
+			return SoundScheduler::Clock::time_point::max();
+		}
+		//~PlayŋN܂ŉȂ
+		if (!isPlayed_) {
+			return SoundScheduler::Clock::time_point::max();
+		}
+
+		ALint state;
+		alGetSourcei(sourceID_, AL_SOURCE_STATE, &state);
+
+		//[vȂŏI[܂Őς񂾂̂I
+		if (state == AL_STOPPED && isStreamEnd_ && !isLoop_) {
+			ExecuteStop();
+			return SoundScheduler::Clock::time_point::max();
+		}
+		if (state != AL_PLAYING) {
+			//Đ̂͂~܂Ă = [Ԃɍ킸L[s
+			//Sobt@ς݂ɂȂĂ̂ŁAÂg炵Ȃ悤lߒĂĐ
+			if (state == AL_STOPPED) {
+				stats_.AddUnderrun();
+				stats_.UpdateLowWaterMark(0);
+				FillBuffer(true);
+				GrowQueue();
+			}
+			stats_.AddRestart();
+			if (isPlayed_) {
+				alSourcePlay(sourceID_);
+			}
+		}
+		else {
+			FillBuffer(false);
+		}
+		//ǂ݂ԂɍĂȂI/Ol߂ɋN̂ŁA͎肱ڂ̕ی
+		if (isStarved_) {
+			return now + GetBufferDuration();
+		}
+		//ʒmȂ炻ŋN̂ŁA͎肱ڂ̕ی
+		if (events_ != nullptr && events_->IsEnable()) {
+			return now + GetBufferDuration() * (numBuffer_ / 2 + 1);
+		}
+		//ĐĂobt@ς݂ɂȂ鎞ɂ܂[
+		return now + GetTimeToProcessed();
+	}
+	//Xg[~Opobt@1̍Đ
+	SoundScheduler::Clock::duration GetBufferDuration() const
+	{
+		long long bytesPerSec = (long long)audio_->GetSamplingRate() * audio_->GetBlockSize();
+		if (bytesPerSec <= 0) {
+			return std::chrono::milliseconds(16);
+		}
+		return std::chrono::microseconds(bufferBytes_ * 1000000LL / bytesPerSec);
+	}
+	//L[̐擪̃obt@ς݂ɂȂ܂ł̎
+	SoundScheduler::Clock::duration GetTimeToProcessed()
+	{
+		ALint queued = 0;
+		alGetSourcei(sourceID_, AL_BUFFERS_QUEUED, &queued);
+		ALint buffer = 0;
+		alGetSourcei(sourceID_, AL_BUFFER, &buffer);
+		if (queued == 0 || buffer == 0) {
+			return GetBufferDuration();
+		}
+		ALint size = 0;
+		alGetBufferi((ALuint)buffer, AL_SIZE, &size);
+
+		//AL_SOFT_source_latency΃Tv̈ʒu܂Ŏ
+		double offset = 0.0;
+		ALExtension& ext = ALExtension::Get();
+		if (ext.hasSourceLatency) {
+			ALint64SOFT values[2] = {};
+			ext.alGetSourcei64vSOFT(sourceID_, AL_SAMPLE_OFFSET_LATENCY_SOFT, values);
+			offset = values[0] / 4294967296.0;
+		}
+		else {
+			ALint sampleOffset = 0;
+			alGetSourcei(sourceID_, AL_SAMPLE_OFFSET, &sampleOffset);
+			offset = sampleOffset;
+		}
+
+		//ς݂菜Ȃ̂ōĐʒu͐擪obt@̈ʒuɂȂ
+		double remaining = size / (double)alBlockSize_ - offset;
+		if (remaining <= 0.0) {
+			return SoundScheduler::Clock::duration::zero();
+		}
+		return std::chrono::microseconds((long long)(remaining * 1000000.0 / alRate_));
+	}
+	void LoadAudio()
+	{
+		//ǂݍ (f[^nč\[X͂g)
+		if (audio_ == nullptr)
+		{
+			AudioDataFactory factory;
+			audio_ = factory.Create(filePass_.c_str());
+		}
+		if (audio_ == nullptr)
+		{
+			throw("not support" + filePass_);
+		}
+
+		//z{CXVirtualVoicePool蓖ĂAL\[XŖ炷̂ŁAł͍Ȃ
+		if (virtualVoices_ == nullptr)
+		{
+			alGetError();
+			alGenSources(1, &sourceID_);
+			//foCX̃\[Xg؂ĂƍȂ
+			if (alGetError() != AL_NO_ERROR)
+			{
+				sourceID_ = 0;
+				throw("can't create source " + filePass_);
+			}
+		}
+		alDistanceModel(AL_EXPONENT_DISTANCE);
+
+		format_ = ToALFormat(audio_->GetFormat());
+		//obt@Oǂݍ
+		switch (mode_) {
+		case LoadMode::Streaming:
+			//Xg[~O[h̓obt@1w̎ԕɂāAobt@L[
+			bufferBytes_ = (int)std::max(1LL, (long long)audio_->GetSamplingRate() * config_.bufferMs / 1000) * audio_->GetBlockSize();
+			alRate_ = audio_->GetSamplingRate();
+			alBlockSize_ = audio_->GetBlockSize();
+			//ϊ鎞͌̎g1ubNǂłAϊ̗̒̈ɏo
+			if (config_.isResample && resampleRate_ > 0 && resampleRate_ != alRate_)
+			{
+				int channels = SoundFormatInfo::GetChannels(audio_->GetFormat());
+				resampler_ = new Resampler(alRate_, resampleRate_, channels);
+				if (resampler_->IsValid())
+				{
+					resampleInput_.resize(bufferBytes_);
+					format_ = channels == 2 ? AL_FORMAT_STEREO16 : AL_FORMAT_MONO16;
+					alRate_ = resampleRate_;
+					alBlockSize_ = channels * 2;
+				}
+				else
+				{
+					delete resampler_;
+					resampler_ = nullptr;
+				}
+			}
+			{
+				int blockBytes = bufferBytes_;
+				if (resampler_ != nullptr)
+				{
+					blockBytes = resampler_->GetMaxOutputFrames(bufferBytes_ / audio_->GetBlockSize()) * alBlockSize_;
+				}
+				if (config_.prefetchDepth > 0)
+				{
+					prefetch_ = new PrefetchRing(config_.prefetchDepth, blockBytes);
+				}
+				else
+				{
+					readBuffer_.resize(blockBytes);
+				}
+			}
+			//ŏ̃L[͓ǂݍݒ̃Xbhł̂܂ܓǂŋl߂ (O蒷Ήxɕ)
+			for (int numQueued = 0; numQueued < numBuffer_;)
+			{
+				if (prefetch_ != nullptr && prefetch_->RequestFill())
+				{
+					PrefetchBlocks();
+				}
+				int count = QueueNewBuffers(numBuffer_ - numQueued);
+				if (count == 0)
+				{
+					break;
+				}
+				numQueued += count;
+			}
+			KickPrefetch();
+			if (events_ != nullptr)
+			{
+				events_->Register(sourceID_, this);
+			}
+			break;
+
+		case LoadMode::AllRead:
+			//I[[h[hׂ͂ēǂŃobt@ɓ˂
+			//t@Cɓǂݍ܂Ă΂̃obt@L (audio_̓LbV)
+			shared_ = cache_->Acquire(filePass_.c_str(), audio_, format_, resampleRate_, isCompress_);
+			audio_ = nullptr;
+			bufferIDs_[0] = shared_->bufferID;
+			if (virtualVoices_ != nullptr)
+			{
+				virtualVoices_->SetBuffer(virtualIndex_, shared_->bufferID, shared_->frames, shared_->samplingRate, shared_->loopStart, shared_->loopEnd);
+			}
+			else
+			{
+				alSourcei(sourceID_, AL_BUFFER, bufferIDs_[0]);
+			}
+			numBuffer_ = 1;
+			break;
+		}
+	}
+	//bN܂ܒm点̂ŁAȍ~thisɐGȂΔjƋȂ
+	void FinishLoad(LoadState state)
+	{
+		std::lock_guard<std::mutex> lock(loadMutex_);
+		loadState_ = state;
+		if (state == LoadState::Ready)
+		{
+			scheduler_->Add(this);
+		}
+		loadCv_.notify_all();
+	}
+	//mۂ̂SЕt (ǂݍ݂ɎsȑԂłĂׂ)
+	void Release()
+	{
+		isEnd_ = true;
+		isPlayed_ = false;
+		//ǂݒȂ炻ꂪÎ҂ (I/Oaudio_ƃXPW[[ɐG)
+		if (prefetch_ != nullptr)
+		{
+			prefetch_->Close();
+		}
+		//Ȃ炻ꂪÎ҂ĂO
+		if (events_ != nullptr)
+		{
+			events_->Unregister(sourceID_);
+		}
+		scheduler_->Remove(this);
+
+		if (sourceID_ != 0)
+		{
+			alSourceStop(sourceID_);
+			alSourcei(sourceID_, AL_BUFFER, AL_NONE);
+		}
+		//Lobt@OɃRs[Đ~߁Az{CXAL\[XԂ
+		if (voices_ != nullptr)
+		{
+			voices_->StopOwner(this);
+		}
+		if (virtualVoices_ != nullptr && virtualIndex_ >= 0)
+		{
+			virtualVoices_->Remove(virtualIndex_);
+			virtualIndex_ = -1;
+		}
+		delete ownVoices_;
+		ownVoices_ = nullptr;
+		delete ownScheduler_;
+		ownScheduler_ = nullptr;
+		delete prefetch_;
+		prefetch_ = nullptr;
+		delete resampler_;
+		resampler_ = nullptr;
+		delete ownIo_;
+		ownIo_ = nullptr;
+		delete audio_;
+		audio_ = nullptr;
+
+		if (sourceID_ != 0)
+		{
+			alDeleteSources(1, &sourceID_);
+			sourceID_ = 0;
+		}
+		//Lobt@̓LbVŎQƂȂɏ
+		if (shared_ != nullptr)
+		{
+			cache_->Release(shared_);
+			shared_ = nullptr;
+		}
+		else
+		{
+			alDeleteBuffers(numGenerated_, bufferIDs_);
+		}
+		delete ownCache_;
+		ownCache_ = nullptr;
+
+		delete[] bufferIDs_;
+		bufferIDs_ = nullptr;
+	}
+	//tɂȂ̂̓XPW[[~܂Ă鎞(ǂݍݒȂ)Ȃ̂ŁA̎̓bNĘeɐς
+	void PushCommand(const Command& command)
+	{
+		if (hasOverflow_ || !commands_.Push(command))
+		{
+			std::lock_guard<std::mutex> lock(overflowMutex_);
+			overflow_.push_back(command);
+			hasOverflow_ = true;
+		}
+		scheduler_->Wake(this);
+	}
+	//lɈtċN (XPW[[lǂޓrŏĂA󂪗̂łxn)
+	void MarkDirty(Dirty flag)
+	{
+		dirty_.fetch_or(flag, std::memory_order_release);
+		scheduler_->Wake(this);
+	}
+	//ς܂ꂽɎsAςʁEʒuExn (XPW[[̃Xbĥ݌Ă)
+	void ExecuteCommands()
+	{
+		Command command;
+		while (commands_.Pop(&command))
+		{
+			ExecuteCommand(command);
+		}
+		//O̕ɐς܂ꂽ̂Ȃ̂ŁAOɂĂs
+		if (hasOverflow_)
+		{
+			std::vector<Command> overflow;
+			{
+				std::lock_guard<std::mutex> lock(overflowMutex_);
+				overflow.swap(overflow_);
+				hasOverflow_ = false;
+			}
+			for (const Command& pending : overflow)
+			{
+				ExecuteCommand(pending);
+			}
+		}
+		std::uint8_t dirty = dirty_.exchange(0, std::memory_order_acquire);
+		if (dirty & DirtyVolume)
+		{
+			alSourcef(sourceID_, AL_MAX_GAIN, volume_);
+		}
+		if (dirty & DirtyPosition)
+		{
+			alSource3f(sourceID_, AL_POSITION, posX_, posY_, posZ_);
+		}
+		if (dirty & DirtyVelocity)
+		{
+			alSource3f(sourceID_, AL_VELOCITY, velocityX_, velocityY_, velocityZ_);
+		}
+	}
+	void ExecuteCommand(const Command& command)
+	{
+		switch (command.type)
+		{
+		case CommandType::Play:
+			ExecutePlay(command.loop);
+			break;
+		case CommandType::PlayCopy:
+			ExecutePlayCopy();
+			break;
+		case CommandType::Pause:
+			isPlayed_ = false;
+			alSourcePause(sourceID_);
+			break;
+		case CommandType::Stop:
+			ExecuteStop();
+			break;
+		}
+	}
+	//isPlayed_͌ĂяołAς񂾏Ɏsʂŏ㏑
+	//(StopPlayƑČĂԂƁAɎsStopisPlayed_|܂܂ɂȂ̂)
+	void ExecutePlay(bool loop)
+	{
+		isPlayed_ = true;
+		isLoop_ = loop;
+		ALint state;
+		alGetSourcei(sourceID_, AL_SOURCE_STATE, &state);
+		if (state == AL_PLAYING)
+		{
+			return;
+		}
+		//~Őǂ݂Ԃɍ킸ɐς߂ȂŐς
+		if (mode_ == LoadMode::Streaming)
+		{
+			TopUpQueue();
+		}
+		alSourcePlay(sourceID_);
+	}
+	void ExecutePlayCopy()
+	{
+		isLoop_ = false;
+		voices_->Play(this, bufferIDs_[0], volume_);
+	}
+	void ExecuteStop()
 	{
-		//ĐI폜
-		while (!isEnd_) {
-			//1bɈłsł͂邪AƂ肠60FPS̃EFCg
-			std::this_thread::sleep_for(std::chrono::milliseconds(16));
+		isPlayed_ = false;
+		//I[[h[h͋Lobt@Ȃ̂Ŋ߂
+		if (mode_ == LoadMode::AllRead)
+		{
+			alSourceStop(sourceID_);
+			alSourceRewind(sourceID_);
+			return;
+		}
+		//~ƑSobt@ς݂ɂȂ̂őSOĂ擪lߒ
+		alSourceStop(sourceID_);
+		int num;
+		ALuint soundBuffer;
+		while (alGetSourcei(sourceID_, AL_BUFFERS_PROCESSED, &num), num > 0) {
+			alSourceUnqueueBuffers(sourceID_, 1, &soundBuffer);
+		}
 
-			std::lock_guard<std::recursive_mutex> lock(mutex_);
-			for (auto it = copySources_.begin(); it != copySources_.end();)
+		SeekStream(0);
+		isStreamEnd_ = false;
+		//SOꂽ̂ŁA\ɉ񂵂Ă̂܂߂čĂobt@lߒ
+		spareBuffers_.assign(bufferIDs_, bufferIDs_ + numGenerated_);
+		QueueNewBuffers(numBuffer_);
+	}
+	//\Vobt@ɑl߂ăL[̌ɐς݁Aς񂾐Ԃ
+	//ǂ݂ԂɍĂȂ΂Ŏ~߂
+	int QueueNewBuffers(int count)
+	{
+		int numQueued = 0;
+		while (numQueued < count)
+		{
+			if (spareBuffers_.empty() && numGenerated_ >= capacity_)
 			{
-				ALint state;
-				alGetSourcei((*it), AL_SOURCE_STATE, &state);
+				break;
+			}
+			//[vȂȂI[̐͐ς܂Ȃ
+			if (isStreamEnd_ && !isLoop_)
+			{
+				break;
+			}
+			const char* data = nullptr;
+			int readSize = 0;
+			bool isLoopEnd = false;
+			if (!TakeBlock(&data, &readSize, &isLoopEnd))
+			{
+				break;
+			}
+			ALuint soundBuffer;
+			if (!spareBuffers_.empty())
+			{
+				soundBuffer = spareBuffers_.back();
+				spareBuffers_.pop_back();
+			}
+			else
+			{
+				alGenBuffers(1, &bufferIDs_[numGenerated_]);
+				soundBuffer = bufferIDs_[numGenerated_++];
+			}
+			alBufferData(soundBuffer, format_, data, readSize, alRate_);
+			alSourceQueueBuffers(sourceID_, 1, &soundBuffer);
+			ReleaseBlock();
+			++numQueued;
+			isStreamEnd_ = isLoopEnd;
+		}
+		return numQueued;
+	}
+	//ǂ݂Ԃɍ킸ɐς߂Ȃςݑ
+	void TopUpQueue()
+	{
+		int numQueued = 0;
+		alGetSourcei(sourceID_, AL_BUFFERS_QUEUED, &numQueued);
+		if (numQueued < numBuffer_)
+		{
+			QueueNewBuffers(numBuffer_ - numQueued);
+		}
+	}
+	//K[hŃA_[̓L[1.5{ɐL΂Ďɔ
+	void GrowQueue()
+	{
+		if (!config_.isAdaptive || !isPlayed_)
+		{
+			return;
+		}
+		int current = numBuffer_;
+		int target = std::min(config_.maxBuffer, current + std::max(1, current / 2));
+		numBuffer_ = target;
+		QueueNewBuffers(target - current);
+		healthyRefills_ = 0;
+		minPending_ = INT_MAX;
+	}
+	//K[hŁAL[8ԂƔȏcĂ1/4炷
+	//炵͏ς݂ɂȂɐςݒɗ\ɉ
+	void ShrinkQueueIfHealthy(int numPending, int numProcessed)
+	{
+		if (!config_.isAdaptive)
+		{
+			return;
+		}
+		minPending_ = std::min(minPending_, numPending);
+		healthyRefills_ += numProcessed;
+		int current = numBuffer_;
+		if (healthyRefills_ < current * 8)
+		{
+			return;
+		}
+		if (minPending_ > current / 2)
+		{
+			numBuffer_ = std::max(config_.minBuffer, current - std::max(1, current / 4));
+		}
+		healthyRefills_ = 0;
+		minPending_ = INT_MAX;
+	}
+	//isUnderrun̓L[sĎ~܂̋lߒ (Đʒûŕ[x͑Ȃ)
+	void FillBuffer(bool isUnderrun)
+	{
+		//ς݃L[Ȃꍇ͎̕[܂ő҂̂ł̂܂܋A
+		int numProcessed = 0;
+		alGetSourcei(sourceID_, AL_BUFFERS_PROCESSED, &numProcessed);
+		int numQueued = 0;
+		alGetSourcei(sourceID_, AL_BUFFERS_QUEUED, &numQueued);
+		//Đʒu̓L[̐擪(ς݂܂)̃TvȂ̂ŁA
+		//Oobt@̒ɈƂ̃obt@ς݂ɂȂĂ̌o߂ɂȂ
+		int playedFrames = 0;
+		if (numProcessed > 0 && !isUnderrun) {
+			stats_.UpdateLowWaterMark(numQueued - numProcessed);
+			ShrinkQueueIfHealthy(numQueued - numProcessed, numProcessed);
+			alGetSourcei(sourceID_, AL_SAMPLE_OFFSET, &playedFrames);
+		}
+		//[vȂŏI[܂Őς񂾌͕[Ac肪Î҂ (~߂̂Update)
+		while (isPlayed_ && numProcessed > 0 && !(isStreamEnd_ && !isLoop_)) {
+			//炵ĂrȂςݒɗ\ɉ
+			bool isSpare = numQueued > numBuffer_;
+			const char* data = nullptr;
+			int readSize = 0;
+			bool isLoopEnd = false;
+			//ǂ݂ԂɍĂȂΏς݂̂܂܎cĂAI/OɋNĂ[
+			if (!isSpare && !TakeBlock(&data, &readSize, &isLoopEnd)) {
+				break;
+			}
+
+			ALuint soundBuffer;
+			alSourceUnqueueBuffers(sourceID_, 1, &soundBuffer);
+			if (isUnderrun) {
+				stats_.AddRefill(-1);
+			}
+			else {
+				ALint size = 0;
+				alGetBufferi(soundBuffer, AL_SIZE, &size);
+				playedFrames -= size / alBlockSize_;
+				stats_.AddRefill(playedFrames > 0 ? playedFrames * 1000000LL / alRate_ : 0);
+			}
+			--numProcessed;
+			if (isSpare) {
+				--numQueued;
+				spareBuffers_.push_back(soundBuffer);
+				continue;
+			}
+
+			alBufferData(soundBuffer, format_, data, readSize, alRate_);
+			alSourceQueueBuffers(sourceID_, 1, &soundBuffer);
+			ReleaseBlock();
+			isStreamEnd_ = isLoopEnd;
+		}
+		//~ȂǂŐς߂ĂȂΐςݑ
+		if (isPlayed_ && numQueued < numBuffer_) {
+			TopUpQueue();
+		}
+	}
+	//[Ɏg̃ubN󂯎Bǂ݂Ă΃O̐擪AĂȂ΂̏œǂ
+	//gIReleaseBlockĂԂƁBǂ݂ԂɍĂȂfalse
+	bool TakeBlock(const char** data, int* readSize, bool* isLoopEnd)
+	{
+		if (prefetch_ == nullptr) {
+			*data = ReadOutputBlock(readBuffer_.data(), readSize, isLoopEnd);
+			return true;
+		}
+		//I/Ol߂ɋNĂ炦悤AɗĂĂ猩
+		isStarved_ = true;
+		int numReady = 0;
+		const PrefetchRing::Block* block = prefetch_->Front(&numReady);
+		if (block == nullptr) {
+			//~Ċ߂͊ԂɍȂēRȂ̂ŐȂ
+			if (isPlayed_) {
+				stats_.AddPrefetchMiss();
+			}
+			return false;
+		}
+		isStarved_ = false;
+		stats_.AddPrefetchHit(numReady);
+		*data = block->data;
+		*readSize = block->size;
+		*isLoopEnd = block->isLoopEnd;
+		return true;
+	}
+	void ReleaseBlock()
+	{
+		if (prefetch_ != nullptr) {
+			prefetch_->Pop();
+			KickPrefetch();
+		}
+	}
+	//Oɋ󂫂AI/OĂȂΐǂ݂ς
+	void KickPrefetch()
+	{
+		if (prefetch_ != nullptr && prefetch_->RequestFill()) {
+			io_->Push([this] { PrefetchBlocks(); });
+		}
+	}
+	//ɓǂވʒuςBǂ݂ĂΓǂł镪̂Ăēǂݒ
+	void SeekStream(int pcmOffset)
+	{
+		if (prefetch_ == nullptr) {
+			audio_->Seek(pcmOffset);
+			if (resampler_ != nullptr) {
+				resampler_->Reset();
+			}
+			return;
+		}
+		prefetch_->Reset(pcmOffset);
+		KickPrefetch();
+	}
+	//I/ÕXbhŁAOtɂȂ܂œǂ (Ɏŝ1)
+	void PrefetchBlocks()
+	{
+		PrefetchRing::Block* block = nullptr;
+		unsigned generation = 0;
+		int seekTo = -1;
+		while (prefetch_->BeginWrite(&block, &generation, &seekTo)) {
+			if (seekTo >= 0) {
+				audio_->Seek(seekTo);
+				if (resampler_ != nullptr) {
+					resampler_->Reset();
+				}
+			}
+			block->data = ReadOutputBlock(block->storage.data(), &block->size, &block->isLoopEnd);
+			//}bvς݂̗̈͂ŐGăy[Wǂݍ܂Ă ([Ńy[WtHg҂Ȃ悤)
+			if (block->data != block->storage.data()) {
+				TouchPages(block->data, block->size);
+			}
+			if (prefetch_->EndWrite(generation) && isStarved_.exchange(false)) {
+				scheduler_->Wake(this);
+			}
+		}
+	}
+	static void TouchPages(const char* data, int size)
+	{
+		volatile char sink = 0;
+		for (int i = 0; i < size; i += 4096) {
+			sink = sink + data[i];
+		}
+	}
+	//ALobt@ɓn1ubNpӂBϊ鎞͌̎gœǂłϊbufferɏ
+	//[v̌pڂ͓ǂޑłȂł̂ŁAῗ̂܂ܑĒʂΓr؂Ȃ
+	const char* ReadOutputBlock(char* buffer, int* readSize, bool* isLoopEnd)
+	{
+		if (resampler_ == nullptr) {
+			return ReadNextBlock(buffer, readSize, isLoopEnd);
+		}
+		int size = 0;
+		const char* data = ReadNextBlock(resampleInput_.data(), &size, isLoopEnd);
+		int frames = size / audio_->GetBlockSize();
+		//8bitfloat16bitɂĂʂ
+		const std::int16_t* pcm = SoundFormatInfo::ToS16(data, (size_t)frames * SoundFormatInfo::GetChannels(audio_->GetFormat()), audio_->GetFormat(), &widened_);
+		*readSize = resampler_->Process(pcm, frames, (std::int16_t*)buffer) * alBlockSize_;
+		return buffer;
+	}
+	//obt@1ǂށB[vI[ɒB烋[vJnʒuɖ߂Ac𓯂obt@ɑċl߂
+	//(pڂŔ[ȃobt@炸ATvPʂœr؂ꂸɂȂ)
+	//[vȂ̓[vI[̐([X)t@C̏I[܂œǂ݁AŃobt@؂
+	//ǂI[܂߂isLoopEnd𗧂āAɓǂނ̂̓[vJnʒu
+	const char* ReadNextBlock(char* buffer, int* readSize, bool* isLoopEnd)
+	{
+		bool isLoop = isLoop_;
+		int end = isLoop ? audio_->GetLoopStart() + audio_->GetLoopLength() : audio_->GetPcmSize();
+		const char* data = buffer;
+		*readSize = 0;
+		*isLoopEnd = false;
+		while (*readSize < bufferBytes_) {
+			//I[zȂ悤ɓǂݍݗʂ߂ ([vI[ɂ0ɂȂAJnʒuɖ߂)
+			int fillSize = bufferBytes_ - *readSize;
+			if (fillSize > (end - audio_->GetPcmOffset()) * audio_->GetBlockSize()) {
+				fillSize = (end - audio_->GetPcmOffset()) * audio_->GetBlockSize();
+			}
+			int size = 0;
+			const char* view = fillSize > 0 ? ReadBlock(buffer + *readSize, fillSize, &size) : buffer;
+			//pڂ΃}bvς݂̗̈̂܂ܕԂApbufferɏW߂
+			if (*readSize == 0) {
+				data = view;
+			}
+			else if (size > 0) {
+				if (data != buffer) {
+					memcpy(buffer, data, *readSize);
+					data = buffer;
+				}
+				if (view != buffer + *readSize) {
+					memcpy(buffer + *readSize, view, size);
+				}
+			}
+			*readSize += size;
+			if (size > 0 && audio_->GetPcmOffset() < end) {
+				continue;
+			}
+			//߂ɂǂ߂Ȃ̂̓[vȂ̂Œ߂
+			if (size == 0 && *isLoopEnd) {
+				break;
+			}
+			//I[(܂̓t@C؂Ă鏊)ɒB̂ŊJnʒuɖ߂đl߂
+			*isLoopEnd = true;
+			audio_->Seek(audio_->GetLoopStart());
+			if (!isLoop) {
+				break;
+			}
+		}
+		return data;
+	}
+	int  ReadBuffer(char* buffer, int maxReadSize)
+	{
+		//readBuffer܂܂œǂ݂
+		int readSize = 0;
+		while (readSize != maxReadSize) {
+			int singleReadSize = audio_->Read(buffer + readSize, maxReadSize - readSize);
+			if (singleReadSize <= 0) {
+				break;
+			}
+			readSize += singleReadSize;
+		}
+		if (readSize == 0) {
+			return 0;
+		}
+
+		return readSize;
+	}
+	//}bvς݂̃f[^̓Rs[ɂ̗̈ԂAȊObufferɓǂݍbufferԂ
+	const char* ReadBlock(char* buffer, int maxReadSize, int* readSize)
+	{
+		const char* view = audio_->ReadView(maxReadSize, readSize);
+		if (view != nullptr)
+		{
+			stats_.AddBytesRead(*readSize);
+			return view;
+		}
+		*readSize = ReadBuffer(buffer, maxReadSize);
+		stats_.AddBytesRead(*readSize);
+		return buffer;
+	}
+};
+//\[ẌʒuExEʂt[Ƃɂ܂Ƃ߂AL֓n
+//l̓Xbg(SoundHandleindex)Ƃɗvfʂ̔zŎAOnlƓȂ牽Ȃ
+//ς̂tĂAFlushňxAL_SOFT_deferred_updates(alcSuspendContext)̒œn
+//~LT[͑S̕ύX𓯂^C~OŔfA\[XƂɃXPW[[NƂ
+class SourceUpdateBatch
+{
+public:
+	enum Dirty : std::uint8_t {
+		DirtyPosition = 1,
+		DirtyVelocity = 2,
+		DirtyVolume = 4,
+	};
+private:
+	std::vector<SoundSource*> sources_;
+	//ŌɎ󂯎l (܂nĂȂ̂NaNɂĕKωƂ݂Ȃ)
+	std::vector<float> posX_, posY_, posZ_;
+	std::vector<float> velocityX_, velocityY_, velocityZ_;
+	std::vector<float> volume_;
+	std::vector<std::uint8_t> dirty_;
+	//̕tXbg (SXbgr߂ɍςނ悤)
+	std::vector<std::uint32_t> dirtyList_;
+	//󂯎ƁAl̂Ŏ̂Ă
+	long long submitted_;
+	long long coalesced_;
+public:
+	SourceUpdateBatch()
+	{
+		submitted_ = 0;
+		coalesced_ = 0;
+	}
+	//XbgɃ\[Xѕt (g񂵂Xbg͑O̒lY)
+	void Attach(std::uint32_t slot, SoundSource* source)
+	{
+		if (slot >= sources_.size())
+		{
+			size_t size = slot + 1;
+			const float unknown = std::numeric_limits<float>::quiet_NaN();
+			sources_.resize(size, nullptr);
+			posX_.resize(size, unknown);
+			posY_.resize(size, unknown);
+			posZ_.resize(size, unknown);
+			velocityX_.resize(size, unknown);
+			velocityY_.resize(size, unknown);
+			velocityZ_.resize(size, unknown);
+			volume_.resize(size, unknown);
+			dirty_.resize(size, 0);
+		}
+		Forget(slot);
+		sources_[slot] = source;
+	}
+	//\[XOɌĂԁB܂nĂȂύX̂Ă
+	void Forget(std::uint32_t slot)
+	{
+		if (slot >= sources_.size())
+		{
+			return;
+		}
+		const float unknown = std::numeric_limits<float>::quiet_NaN();
+		sources_[slot] = nullptr;
+		posX_[slot] = posY_[slot] = posZ_[slot] = unknown;
+		velocityX_[slot] = velocityY_[slot] = velocityZ_[slot] = unknown;
+		volume_[slot] = unknown;
+		dirty_[slot] = 0;
+	}
+	void SetPosition(std::uint32_t slot, float x, float y, float z)
+	{
+		++submitted_;
+		if (x == posX_[slot] && y == posY_[slot] && z == posZ_[slot])
+		{
+			++coalesced_;
+			return;
+		}
+		posX_[slot] = x;
+		posY_[slot] = y;
+		posZ_[slot] = z;
+		Mark(slot, DirtyPosition);
+	}
+	void SetVelocity(std::uint32_t slot, float x, float y, float z)
+	{
+		++submitted_;
+		if (x == velocityX_[slot] && y == velocityY_[slot] && z == velocityZ_[slot])
+		{
+			++coalesced_;
+			return;
+		}
+		velocityX_[slot] = x;
+		velocityY_[slot] = y;
+		velocityZ_[slot] = z;
+		Mark(slot, DirtyVelocity);
+	}
+	void SetVolume(std::uint32_t slot, float volume)
+	{
+		++submitted_;
+		if (volume == volume_[slot])
+		{
+			++coalesced_;
+			return;
+		}
+		volume_[slot] = volume;
+		Mark(slot, DirtyVolume);
+	}
+	//̕t̂܂Ƃ߂AL֓nAnڐԂ
+	//ǂݍݒ̃\[X͈cĂAǂݍ݂IFlushœn
+	int Flush(ALCcontext* context)
+	{
+		if (dirtyList_.empty())
+		{
+			return 0;
+		}
+		ALExtension& ext = ALExtension::Get();
+		if (ext.hasDeferredUpdates)
+		{
+			ext.alDeferUpdatesSOFT();
+		}
+		else
+		{
+			alcSuspendContext(context);
+		}
+		int applied = 0;
+		size_t numPending = 0;
+		for (std::uint32_t slot : dirtyList_)
+		{
+			SoundSource* source = sources_[slot];
+			std::uint8_t dirty = dirty_[slot];
+			if (source == nullptr || dirty == 0)
+			{
+				dirty_[slot] = 0;
+				continue;
+			}
+			if (!source->IsReady())
+			{
+				dirtyList_[numPending++] = slot;
+				continue;
+			}
+			if (dirty & DirtyPosition)
+			{
+				source->ApplyPosition(posX_[slot], posY_[slot], posZ_[slot]);
+				++applied;
+			}
+			if (dirty & DirtyVelocity)
+			{
+				source->ApplyVelocity(velocityX_[slot], velocityY_[slot], velocityZ_[slot]);
+				++applied;
+			}
+			if (dirty & DirtyVolume)
+			{
+				source->ApplyVolume(volume_[slot]);
+				++applied;
+			}
+			dirty_[slot] = 0;
+		}
+		dirtyList_.resize(numPending);
+		if (ext.hasDeferredUpdates)
+		{
+			ext.alProcessUpdatesSOFT();
+		}
+		else
+		{
+			alcProcessContext(context);
+		}
+		return applied;
+	}
+	long long GetSubmitted() const
+	{
+		return submitted_;
+	}
+	long long GetCoalesced() const
+	{
+		return coalesced_;
+	}
+private:
+	void Mark(std::uint32_t slot, Dirty flag)
+	{
+		if (dirty_[slot] == 0)
+		{
+			dirtyList_.push_back(slot);
+		}
+		dirty_[slot] |= flag;
+	}
+};
+//LoadBankɓnꗗ1s
+struct SoundBankEntry
+{
+	std::string name;
+	std::string filePass;
+	SoundSource::LoadMode mode;
+	StreamingConfig config;
 
-				if (state != AL_PLAYING)
-				{
-					alDeleteSources(1, &(*it));
-					it = copySources_.erase(it);
-					continue;
+	SoundBankEntry()
+	{
+		mode = SoundSource::LoadMode::AllRead;
+	}
+	//1sɁu\[X t@C̃pX [all|stream]v󔒋؂ŏꗗǂ
+	//[hȗAllReadBs#Ŏn܂s͔΂ (pXɋ󔒂͎gȂ)
+	//ǂ߂Ȃs΁A܂ł̕entriesɑfalseԂ
+	static bool ReadManifest(const char* filePass, std::vector<SoundBankEntry>* entries)
+	{
+		std::ifstream file(filePass);
+		if (!file) {
+			return false;
+		}
+		std::string line;
+		while (std::getline(file, line)) {
+			std::istringstream fields(line);
+			SoundBankEntry entry;
+			std::string mode;
+			if (!(fields >> entry.name) || entry.name[0] == '#') {
+				continue;
+			}
+			if (!(fields >> entry.filePass)) {
+				return false;
+			}
+			if (fields >> mode) {
+				if (mode == "stream" || mode == "streaming") {
+					entry.mode = SoundSource::LoadMode::Streaming;
+				}
+				else if (mode != "all" && mode != "allread") {
+					return false;
 				}
-				++it;
 			}
+			entries->push_back(entry);
 		}
-
-		for (auto i : copySources_) {
-			alDeleteSources(1, &i);
-		}
+		return true;
 	}
-	void EndThread()
+};
+//LoadBanǩ (Ԃׂ͂ă~b)
+struct SoundBankReport
+{
+	struct File
 	{
-		alSourceStop(sourceID_);
-		alSourcei(sourceID_, AL_BUFFER, AL_NONE);
+		std::string name;
+		//ǂ߂ȂAOdȂĂΖȃnh
+		SoundHandle handle;
+		//LoadBankĂłǂݍ݂̃Xbh肩܂
+		double waitMs;
+		//wb_[̉͂ƁAAllReadȂS̓ǂݍ݂ƕϊ (ǂݍ݂̃Xbh)
+		double readMs;
+		//OpenALւ̓]ƃ\[X̍쐬 (ĂяõXbh)
+		double uploadMs;
+		//AllReadOpenALɓnoCg (L̂0)
+		long long bufferBytes;
+		bool isLoaded;
+	};
+	std::vector<File> files;
+	//LoadBankĂł߂܂
+	double totalMs;
+	//ĂяõXbhŃAbv[hɎgԂ̍v
+	double uploadMs;
+	int numLoaded;
+	//Abv[h܂Ƃ߂čs
+	int numBatch;
 
-		std::lock_guard<std::recursive_mutex> lock(mutex_);
-		isEnd_ = true;
-		isPlayed_ = false;
+	SoundBankReport()
+	{
+		totalMs = 0.0;
+		uploadMs = 0.0;
+		numLoaded = 0;
+		numBatch = 0;
 	}
-	void FillBuffer()
+};
+class SoundClass final
+{
+private:
+	ALCdevice* device;
+	ALCcontext* context;
+	//o^\[XBnhňΔz̓Yōς
+	struct SourceEntry
 	{
-		int size = 0;
-
-		char buffer[4096];
-		int fillSize = 4096;
-		int offset = audio_->GetPcmOffset();
-		int loopEnd = audio_->GetLoopStart() + audio_->GetLoopLength();
+		SoundSource* source;
+		std::string name;
+		std::uint32_t id;
+	};
+	SlotMap<SourceEntry> sources;
+	//c[Ȃǂ疼OSoundId::Hash̒lň߂̍
+	std::unordered_map<std::string, SoundHandle> sourceNames;
+	std::unordered_map<std::uint32_t, SoundHandle> sourceIds;
+	//SetPositionsȂǂŎ󂯎ύXFlushUpdates܂Œ߂Ă
+	SourceUpdateBatch updates;
+	//AllRead̃\[Xmœt@C̃obt@L
+	SoundBufferCache* cache;
+	//S\[X̃obt@[󂯎 (\[XƂɃXbh𗧂ĂȂ)
+	SoundScheduler* scheduler;
+	BufferEventListener* events;
+	//S\[XPlayCopyŎgAL\[X
+	VoicePool* voices;
+	//SetVirtualVoicesŗLɂ
+	VirtualVoicePool* virtualVoices;
+	//z{CXAL\[Xmۂ鎞ɁAōXg[~Õ\[XpɎcĂ
+	static constexpr int ReservedStreamingSource = 16;
+	//CreateSourceAsync̓ǂݍ݂s
+	WorkerPool* loader;
+	//Xg[~O̐ǂ݂s (ǂݍ݂̒ɑ҂Ȃ悤loaderƂ͕)
+	WorkerPool* prefetcher;
+	SoundEnvironment environment;
+	//[vobNfoCX̎g (ʏ̃foCXȂ0)
+	int loopbackRate;
+	//[vobNRendert[̍v
+	long long renderedFrames;
+	//ALC_SOFT_device_clockɃ~bNX̑Ɏg
+	std::chrono::steady_clock::time_point startTime;
+	//S\[X̃JE^[̍v (폜\[X̕c)
+	SoundStats stats;
+	//CreateMixerō~LT[ (\[Xɔj)
+	std::vector<SoftwareMixer*> mixers;
+	//ÕnbṼ\[XƏdȂĂȂΓo^ł
+	bool CanRegister(const char* sourceName) const
+	{
+		return sourceNames.find(sourceName) == sourceNames.end() && sourceIds.find(SoundId::Hash(sourceName)) == sourceIds.end();
+	}
+	SoundHandle Register(const char* sourceName, SoundSource* audioSource)
+	{
+		SourceEntry entry;
+		entry.source = audioSource;
+		entry.name = sourceName;
+		entry.id = SoundId::Hash(sourceName);
+		SoundHandle handle = sources.Insert(entry);
+		updates.Attach(handle.index, audioSource);
+		sourceNames[entry.name] = handle;
+		sourceIds[entry.id] = handle;
+		return handle;
+	}
+	//LoadBankLoadPackedBank̖{́Bopenloader̃XbhĂ΂Amanifest[index]̃f[^ĕԂ
+	int LoadBankEntries(const std::vector<SoundBankEntry>& manifest, const std::function<IAudioData*(int)>& open, SoundBankReport* report, int batchSize)
+	{
+		using Clock = std::chrono::steady_clock;
+		auto toMs = [](Clock::duration duration) { return std::chrono::duration<double, std::milli>(duration).count(); };
+		Clock::time_point begin = Clock::now();
+		batchSize = std::max(1, batchSize);
 
-		//4096oCg胋[vI[܂ł̋ZƂ͂ǂݍݗʂƂ
-		if (fillSize > (loopEnd - offset) * audio_->GetBlockSize()) {
-			fillSize = (loopEnd - offset) * audio_->GetBlockSize();
-		}
+		//ǂݍ݂̃XbhAfinishedɐς񂾌͌ĂяõXbhG
+		struct Job
+		{
+			IAudioData* audio;
+			SoundBufferCache::Pending pending;
+			bool isPrepared;
+			//t@CǂސAllRead̓Y (ǂނȂ-1)
+			int primary;
+			bool isUploaded;
+			SoundBankReport::File file;
+		};
+		std::vector<Job> jobs(manifest.size());
+		std::mutex mutex;
+		std::condition_variable cv;
+		std::deque<int> finished;
+		std::unordered_set<std::string> names;
+		std::unordered_map<std::string, int> readers;
+		int numPushed = 0;
 
-		//ς݃L[Ȃꍇ͂̂܂܋A\
-		int numProcessed = 0;
-		while (isPlayed_) {
-			alGetSourcei(sourceID_, AL_BUFFERS_PROCESSED, &numProcessed);
-			if (numProcessed == 0) 
+		for (int i = 0; i < (int)manifest.size(); ++i)
+		{
+			const SoundBankEntry& entry = manifest[i];
+			Job& job = jobs[i];
+			job.audio = nullptr;
+			job.isPrepared = false;
+			job.primary = -1;
+			job.isUploaded = false;
+			job.file.name = entry.name;
+			job.file.waitMs = 0.0;
+			job.file.readMs = 0.0;
+			job.file.uploadMs = 0.0;
+			job.file.bufferBytes = 0;
+			job.file.isLoaded = false;
+			//\[X(Ƃ̃nbV)̏d͈ꗗ̒młȂ
+			if (!CanRegister(entry.name.c_str()) || !names.insert(entry.name).second)
 			{
-				std::this_thread::sleep_for(std::chrono::milliseconds(600));
 				continue;
 			}
+			if (entry.mode == SoundSource::LoadMode::AllRead)
+			{
+				auto it = readers.emplace(entry.filePass, i);
+				if (!it.second)
+				{
+					job.primary = it.first->second;
+				}
+			}
+			++numPushed;
+			int resampleRate = environment.resampleRate;
+			bool isCompress = environment.isCompress;
+			SoundBufferCache* cache = this->cache;
+			loader->Push([&, i, resampleRate, isCompress, cache]
+			{
+				Job& job = jobs[i];
+				const SoundBankEntry& entry = manifest[i];
+				Clock::time_point start = Clock::now();
+				job.file.waitMs = toMs(start - begin);
+				try
+				{
+					job.audio = open(i);
+					//ɃLbVɂ͓̂ǂ܂Ȃ (\[X鎞ɋL)
+					if (job.audio != nullptr && entry.mode == SoundSource::LoadMode::AllRead && job.primary < 0 &&
+						!cache->Contains(SoundBufferCache::GetKey(entry.filePass.c_str(), job.audio, resampleRate, isCompress)))
+					{
+						SoundBufferCache::Prepare(entry.filePass.c_str(), job.audio, SoundSource::ToALFormat(job.audio->GetFormat()), resampleRate, isCompress, &job.pending);
+						job.isPrepared = true;
+					}
+				}
+				catch (...)
+				{
+					delete job.audio;
+					job.audio = nullptr;
+					job.isPrepared = false;
+				}
+				job.file.readMs = toMs(Clock::now() - start);
+				//Ō1󂯎LoadBank߂cvȂ̂ŁAbN܂ܒm点
+				std::lock_guard<std::mutex> lock(mutex);
+				finished.push_back(i);
+				cv.notify_one();
+			});
+		}
 
-			ALuint soundBuffer;
-			alSourceUnqueueBuffers(sourceID_, 1, &soundBuffer);
-
-			int readSize = ReadBuffer(buffer, fillSize - size);
-			alBufferData(soundBuffer, format_, buffer, readSize, audio_->GetSamplingRate());
-			alSourceQueueBuffers(sourceID_, 1, &soundBuffer);
-
-			offset = audio_->GetPcmOffset();
-			if (readSize == 0 || offset == loopEnd) {
-				//[vȂꍇ͏I[ɒBXg[~O~
-				if (isLoop_) 
+		//L鑤́AǂޑAbv[hς܂܂ő҂ (ɍƎœǂݒĂ܂)
+		std::vector<int> waiting;
+		std::vector<int> batch;
+		int numDone = 0;
+		while (numDone < numPushed)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				cv.wait(lock, [&] { return !finished.empty(); });
+				//܂Ă镪܂Ƃ߂Ď󂯎 (1NăAbv[hא؂ɂȂȂ悤)
+				while (!finished.empty() && (int)batch.size() < batchSize)
 				{
-					audio_->Seek(audio_->GetLoopStart());
-					offset = audio_->GetLoopStart();
-					//std::cout << "Loop!" << std::endl;
+					batch.push_back(finished.front());
+					finished.pop_front();
 				}
-				else
+			}
+			Clock::time_point batchBegin = Clock::now();
+			for (int index : batch)
+			{
+				if (jobs[index].primary >= 0 && !jobs[jobs[index].primary].isUploaded)
 				{
-					Stop();
-					break;
+					waiting.push_back(index);
+					continue;
 				}
+				CreateBankSource(manifest[index], &jobs[index].audio, &jobs[index].pending, jobs[index].isPrepared, &jobs[index].file);
+				jobs[index].isUploaded = true;
+				++numDone;
 			}
+			batch.clear();
+			//ǂޑI(܂͎s)̂
+			for (size_t w = 0; w < waiting.size();)
+			{
+				int index = waiting[w];
+				if (!jobs[jobs[index].primary].isUploaded)
+				{
+					++w;
+					continue;
+				}
+				CreateBankSource(manifest[index], &jobs[index].audio, &jobs[index].pending, jobs[index].isPrepared, &jobs[index].file);
+				jobs[index].isUploaded = true;
+				++numDone;
+				waiting[w] = waiting.back();
+				waiting.pop_back();
+			}
+			if (report != nullptr)
+			{
+				report->uploadMs += toMs(Clock::now() - batchBegin);
+				++report->numBatch;
+			}
+		}
 
-			size += readSize;
-			if (size == fillSize) {
-				break;
+		int numLoaded = 0;
+		for (const Job& job : jobs)
+		{
+			if (job.file.isLoaded)
+			{
+				++numLoaded;
+			}
+		}
+		if (report != nullptr)
+		{
+			report->files.clear();
+			for (Job& job : jobs)
+			{
+				report->files.push_back(job.file);
 			}
-			alGetSourcei(sourceID_, AL_BUFFERS_PROCESSED, &numProcessed);
+			report->numLoaded = numLoaded;
+			report->totalMs = toMs(Clock::now() - begin);
 		}
+		return numLoaded;
 	}
-	int  ReadBuffer(char* buffer, int maxReadSize)
+	//LoadBankœǂݏÎOpenAL֓nă\[Xo^ (ReLXg̃XbhŌĂ)
+	//audiȍL̓\[XɈڂ邩As炱Ŕj
+	void CreateBankSource(const SoundBankEntry& entry, IAudioData** audio, SoundBufferCache::Pending* pending, bool isPrepared, SoundBankReport::File* file)
 	{
-		//readBuffer܂܂œǂ݂
-		int readSize = 0;
-		while (readSize != maxReadSize) {
-			char tmp[4096];
-			int size = maxReadSize - readSize;
-			if (size > 4096) {
-				size = 4096;
-			}
-			int singleReadSize = audio_->Read(tmp, size);
-			if (singleReadSize <= 0) {
-				break;
+		using Clock = std::chrono::steady_clock;
+		Clock::time_point start = Clock::now();
+		if (*audio != nullptr)
+		{
+			SoundSource* audioSource = new SoundSource(entry.filePass.c_str(), entry.mode, entry.config, &environment, true);
+			try
+			{
+				if (isPrepared)
+				{
+					file->bufferBytes = pending->size;
+					cache->Upload(pending);
+				}
+				//Loadɓn_audio̓\[X̂̂ɂȂ (sĂ\[X̔jŏ)
+				IAudioData* owned = *audio;
+				*audio = nullptr;
+				audioSource->Load(owned);
+				file->handle = Register(entry.name.c_str(), audioSource);
+				file->isLoaded = true;
 			}
-			for (int i = 0; i < singleReadSize; ++i) {
-				buffer[i + readSize] = tmp[i];
+			catch (...)
+			{
+				delete *audio;
+				*audio = nullptr;
+				file->bufferBytes = 0;
+				delete audioSource;
+				//\[XQƂOɎsAꂽobt@Q0̂܂܎cȂ悤ɂ
+				if (isPrepared)
+				{
+					cache->Discard(pending->key);
+				}
 			}
-			readSize += singleReadSize;
-		}
-		if (readSize == 0) {
-			return 0;
 		}
-
-		return readSize;
+		file->uploadMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
 	}
-};
-class SoundClass final
-{
-private:
-	ALCdevice* device;
-	ALCcontext* context;
-	std::unordered_map<std::string, SoundSource*> source;
 public:
-	SoundClass()
+	//numCopyVoicePlayCopyœɖ点鐔 (OAL\[XmۂĂ)
+	//numLoadThreadCreateSourceAsyncŕsēǂݍސ
+	//loopbackRatew肷ƃXs[J[̑ALC_SOFT_loopback̃foCXJA
+	//Render()Ă񂾕(ԂƊ֌WȂ)XeI16bitŕ`悷
+	//numIoThread̓Xg[~O̐ǂ݂sčs
+	SoundClass(int numSchedulerThread = 1, int numCopyVoice = 64, int numLoadThread = 2, int loopbackRate = 0, int numIoThread = 2)
 	{
 		device = nullptr;
 		context = nullptr;
+		cache = nullptr;
+		scheduler = nullptr;
+		events = nullptr;
+		voices = nullptr;
+		virtualVoices = nullptr;
+		loader = nullptr;
+		prefetcher = nullptr;
+		this->loopbackRate = loopbackRate;
+		renderedFrames = 0;
+		startTime = std::chrono::steady_clock::now();
 
-		device = alcOpenDevice(NULL);
+		const ALCint* attributes = NULL;
+		ALCint loopbackAttributes[] = {
+			ALC_FORMAT_CHANNELS_SOFT, ALC_STEREO_SOFT,
+			ALC_FORMAT_TYPE_SOFT, ALC_SHORT_SOFT,
+			ALC_FREQUENCY, loopbackRate,
+			0
+		};
+		if (loopbackRate > 0)
+		{
+			ALExtension& ext = ALExtension::Get();
+			ext.LoadLoopback();
+			if (!ext.hasLoopback)
+			{
+				throw("OpenAL Initialize Failed : ALC_SOFT_loopback");
+			}
+			device = ext.alcLoopbackOpenDeviceSOFT(NULL);
+			if (device != NULL && ext.alcIsRenderFormatSupportedSOFT(device, loopbackRate, ALC_STEREO_SOFT, ALC_SHORT_SOFT) == ALC_FALSE)
+			{
+				alcCloseDevice(device);
+				throw("OpenAL Initialize Failed : loopback format");
+			}
+			attributes = loopbackAttributes;
+		}
+		else
+		{
+			device = alcOpenDevice(NULL);
+		}
 		if (device == NULL)
 		{
 			throw("OpenAL Initialize Failed : device");
 		}
-		context = alcCreateContext(device, NULL);
+		context = alcCreateContext(device, attributes);
 		if (context == NULL)
 		{
 			alcCloseDevice(device);
@@ -683,42 +4216,451 @@ public:
 			alcCloseDevice(device);
 			throw("OpenAL Initialize Failed : alcMakeContextCullent() Failed");
 		}
+		ALExtension::Get().Load();
+		ALExtension::Get().LoadDeviceClock(device);
+		cache = new SoundBufferCache();
+		scheduler = new SoundScheduler(numSchedulerThread);
+		events = new BufferEventListener(scheduler);
+		voices = new VoicePool(numCopyVoice, scheduler);
+		loader = new WorkerPool(numLoadThread);
+		prefetcher = new WorkerPool(numIoThread);
+		environment.cache = cache;
+		environment.scheduler = scheduler;
+		environment.events = events;
+		environment.voices = voices;
+		environment.stats = &stats;
+		environment.io = prefetcher;
+		environment.virtualVoices = nullptr;
+		environment.resampleRate = 0;
+		environment.isCompress = false;
 	}
 	~SoundClass()
 	{
+		//obt@̂ŃReLXgjOɃ\[XƃLbVЕt
+		//(ǂݍݒ̃\[X͔j̒œǂݍ݂Î҂A܂n܂ĂȂ̂loader~߂鎞ɏ)
+		sources.ForEach([](SoundHandle, SourceEntry& entry)
+		{
+			if (!entry.source->AbandonLoad())
+			{
+				delete entry.source;
+			}
+		});
+		sources.Clear();
+		sourceNames.clear();
+		sourceIds.clear();
+		for (auto mixer : mixers)
+		{
+			delete mixer;
+		}
+		mixers.clear();
+		delete loader;
+		delete prefetcher;
+		delete virtualVoices;
+		delete voices;
+		delete events;
+		delete scheduler;
+		delete cache;
+
 		alcMakeContextCurrent(NULL);
 		alcDestroyContext(context);
 		alcCloseDevice(device);
 	}
-	bool CreateSource(const char* sourceName, const char* filePass, SoundSource::LoadMode mode)
+	//config̓Xg[~Õobt@̒(~b)ƐAK[hAǂ݂obt@̎w
+	//ԂnhŖt[G镪ɂ͕Ȃ (OƏdȂΖȃnh)
+	SoundHandle CreateSourceHandle(const char* sourceName, const char* filePass, SoundSource::LoadMode mode, const StreamingConfig& config = StreamingConfig())
 	{
+		//\[X(Ƃ̃nbV)̏d͋Ȃ
+		if (!CanRegister(sourceName)) {
+			return SoundHandle();
+		}
+		SoundSource* audioSource = new SoundSource(filePass, mode, config, &environment);
+		return Register(sourceName, audioSource);
+	}
+	bool CreateSource(const char* sourceName, const char* filePass, SoundSource::LoadMode mode, const StreamingConfig& config = StreamingConfig())
+	{
+		return CreateSourceHandle(sourceName, filePass, mode, config).IsValid();
+	}
+	//\[Xɓo^āAt@C̓ǂݍ݂͗̃Xbhōs
+	//ǂݍ݂IOPlayȂǂ͐ς܂ĂAI_Ŏs
+	//߂lfutureœǂݍ݂̐ۂ󂯎 (\[XdĂ瑦false)
+	//handlenƓo^\[X̃nhԂ (dĂ疳ȃnh)
+	std::shared_future<bool> CreateSourceAsync(const char* sourceName, const char* filePass, SoundSource::LoadMode mode, const StreamingConfig& config = StreamingConfig(), SoundHandle* handle = nullptr)
+	{
+		if (handle != nullptr) {
+			*handle = SoundHandle();
+		}
 		//\[X̏d͋Ȃ
-		if (source.find(sourceName) != source.end()) {
-			return false;
+		if (!CanRegister(sourceName)) {
+			std::promise<bool> result;
+			result.set_value(false);
+			return result.get_future().share();
 		}
-		SoundSource* audioSource = new SoundSource(filePass, mode);
-		if (!audioSource) {
-			return false;
+		SoundSource* audioSource = new SoundSource(filePass, mode, config, &environment, true);
+		SoundHandle registered = Register(sourceName, audioSource);
+		if (handle != nullptr) {
+			*handle = registered;
 		}
 
-		source[sourceName] = audioSource;
-		return true;
+		//\[Xɓǂݍ݂܂n܂ĂȂ΁Aǂ܂ɏ
+		audioSource->QueueLoad();
+		return loader->Push([audioSource]
+		{
+			return SoundSource::RunQueuedLoad(audioSource);
+		}).share();
+	}
+	//ꗗ̃t@C܂Ƃ߂ēǂݍŃ\[Xo^Ao^łԂ
+	//wb_[̉͂AllRead̓ǂݍ݁Eϊloader̃XbhŕsčsA
+	//OpenALւ̓]ƃ\[X̍쐬́AǂݏÎbatchSizeĂяõXbhł܂Ƃ߂čs
+	//(Xg[~O͍ŏ̃L[̕ǂނ̂ŁA͌ĂяõXbhœǂ)
+	//t@CAllRead͈xǂŃobt@LBOdȂĂ̂Ɠǂ߂Ȃ͔̂΂
+	//reportnƑŜƃt@CƂ̎ԂԂ (files[i]manifest[i]̌)
+	int LoadBank(const std::vector<SoundBankEntry>& manifest, SoundBankReport* report = nullptr, int batchSize = 16)
+	{
+		return LoadBankEntries(manifest, [&manifest](int index)
+		{
+			AudioDataFactory factory;
+			return factory.Create(manifest[index].filePass.c_str());
+		}, report, batchSize);
+	}
+	//AL_test packōoN1񂾂}bvẢS\[XƂēo^āAo^łԂ
+	//\[X̓oN̖̒OŁAt@CpX́uoÑpX#OvɂȂ (AllRead̋L̃pXōs)
+	//wb_[͉͍ς݂Ȃ̂ŁAloader̃XbhAllReadPCMɐG(y[Wǂݍ܂)ϊ邾ɂȂ
+	//oNJȂ0 (reportfiles͋)
+	int LoadPackedBank(const char* filePass, SoundSource::LoadMode mode = SoundSource::LoadMode::AllRead, SoundBankReport* report = nullptr, const StreamingConfig& config = StreamingConfig(), int batchSize = 16)
+	{
+		PackedBank bank;
+		if (!bank.Open(filePass))
+		{
+			if (report != nullptr)
+			{
+				*report = SoundBankReport();
+			}
+			return 0;
+		}
+		std::vector<SoundBankEntry> manifest(bank.GetCount());
+		for (int i = 0; i < bank.GetCount(); ++i)
+		{
+			manifest[i].name = bank.GetName(i);
+			manifest[i].filePass = std::string(filePass) + "#" + manifest[i].name;
+			manifest[i].mode = mode;
+			manifest[i].config = config;
+		}
+		return LoadBankEntries(manifest, [&bank](int index)
+		{
+			return bank.Create(index);
+		}, report, batchSize);
+	}
+	//\tgEFA~LT[Ȁo͂炷Xg[~O\[XsourceNameœo^
+	//ʉLoadMixerSoundœo^ă~LT[PlayŖ炷B~LT[SoundClass̔j܂Ŏg
+	//̒x̓L[Ɛǂ݂̒ɂȂ̂ŁAł͒ZĂ
+	SoftwareMixer* CreateMixer(const char* sourceName, int maxVoice = 4096, const StreamingConfig& config = GetMixerConfig())
+	{
+		//\[X̏d͋Ȃ
+		if (!CanRegister(sourceName)) {
+			return nullptr;
+		}
+		SoftwareMixer* mixer = new SoftwareMixer(GetDeviceRate(), maxVoice);
+		mixers.push_back(mixer);
+		Register(sourceName, new SoundSource(new MixerAudioData(mixer), config, &environment));
+		return mixer;
+	}
+	static StreamingConfig GetMixerConfig()
+	{
+		StreamingConfig config(4, 10);
+		config.prefetchDepth = 1;
+		return config;
+	}
+	//t@CSǂmixerɓo^APlayɓnԍԂ (ǂ߂Ȃ-1)
+	//gႤ̂̓~LT[̎gɕϊĂo^
+	int LoadMixerSound(SoftwareMixer* mixer, const char* filePass)
+	{
+		AudioDataFactory factory;
+		IAudioData* audio = factory.Create(filePass);
+		if (audio == nullptr) {
+			return -1;
+		}
+		std::vector<char> pcm(audio->GetPcmSize() * audio->GetBlockSize());
+		audio->Seek(0);
+		int readSize = 0;
+		while (readSize != (int)pcm.size()) {
+			int singleReadSize = audio->Read(pcm.data() + readSize, (int)pcm.size() - readSize);
+			if (singleReadSize <= 0) {
+				break;
+			}
+			readSize += singleReadSize;
+		}
+		SoundFormat format = audio->GetFormat();
+		int channels = SoundFormatInfo::GetChannels(format);
+		int bits = SoundFormatInfo::GetBits(format);
+		int rate = audio->GetSamplingRate();
+		std::vector<char> converted;
+		if (Resampler::ConvertPcm(pcm.data(), readSize, channels, bits, rate, mixer->GetSamplingRate(), &converted)) {
+			pcm.swap(converted);
+			readSize = (int)pcm.size();
+			bits = 16;
+			rate = mixer->GetSamplingRate();
+		}
+		int index = mixer->AddSound(pcm.data(), readSize / (channels * bits / 8), channels, bits, rate);
+		delete audio;
+		return index;
+	}
+	//ꂩAllRead̃\[XAǂݍݎɃfoCX̎g֕ϊ邩
+	//(StreamingConfig::isResample𗧂ĂXg[~Õ\[X[̓xɕϊ)
+	//Đ̓xOpenALsϊǂݍݎ̈xɂłB쐬ς݂̃\[Xɂ͉eȂ
+	void SetResampleToDevice(bool isEnable)
+	{
+		environment.resampleRate = isEnable ? GetDeviceRate() : 0;
+	}
+	//ꂩAllRead̃\[X̃obt@IMA ADPCMŎ (AL_EXT_IMA4g鎞)
+	//풓郁16bitPCM̖1/4ɂȂ邪tȂ̂ŁAʉ̃oNB쐬ς݂̃\[Xɂ͉eȂ
+	void SetCompressResident(bool isEnable)
+	{
+		environment.isCompress = isEnable;
+	}
+	//ꂩAllRead̃\[Xz{CXɂ邩 (쐬ς݂̃\[Xɂ͉eȂ)
+	//z{CXAL\[XɍĐʒuƉʁEʒuExAFlushUpdates̓x
+	//₷(ʂƋ̏傫)numRealVoice܂AL\[X蓖ĂāA̎̍Đʒu炷
+	//foCX̃\[X𒴂鐔̃\[XĂAɂ̂ꎞIɖȂȂ邾ōς
+	//AL\[X͍ŏɗLɂɃfoCX邾(őnumRealVoice)mۂAȍ~numRealVoice͌Ȃ
+	//numRealVoice0ȉȂGetFreeSourceCount̐ɂ
+	//z{CX̍Đʒu̕ύXFlushUpdatesĂԂ܂ŉɔfȂ
+	void SetVirtualVoices(bool isEnable, int numRealVoice = 0)
+	{
+		if (isEnable && virtualVoices == nullptr)
+		{
+			if (numRealVoice <= 0)
+			{
+				numRealVoice = GetFreeSourceCount();
+			}
+			virtualVoices = new VirtualVoicePool(numRealVoice);
+		}
+		environment.virtualVoices = isEnable ? virtualVoices : nullptr;
+	}
+	//foCXALC_MONO_SOURCESAPlayCopỹ{CXƍ쐬ς݂̃\[XĂ镪ƁA
+	//ōXg[~Õ\[XpReservedStreamingSource (ȂOpenAL Soft̊255Ƃ݂Ȃ)
+	int GetFreeSourceCount()
+	{
+		ALCint numMono = 0;
+		alcGetIntegerv(device, ALC_MONO_SOURCES, 1, &numMono);
+		if (numMono <= 0)
+		{
+			numMono = 255;
+		}
+		int numUsed = voices->GetNumVoice() + ReservedStreamingSource;
+		sources.ForEach([&numUsed](SoundHandle, SourceEntry& entry)
+		{
+			if (!entry.source->IsVirtual())
+			{
+				++numUsed;
+			}
+		});
+		return std::max(0, numMono - numUsed);
+	}
+	//LɂĂȂnullptr
+	VirtualVoicePool* GetVirtualVoices()
+	{
+		return virtualVoices;
+	}
+	//AllRead̃obt@ƂOpenALɓnĂoCg̍v
+	long long GetResidentBytes()
+	{
+		return cache->GetBufferBytes();
+	}
+	//foCX̏o͎g (Ȃ48kHzƂ݂Ȃ)
+	int GetDeviceRate() const
+	{
+		if (loopbackRate > 0) {
+			return loopbackRate;
+		}
+		ALCint rate = 0;
+		alcGetIntegerv(device, ALC_FREQUENCY, 1, &rate);
+		return rate > 0 ? rate : 48000;
 	}
 	void DeleteSource(const char* sourceName)
 	{
-		if (source.find(sourceName) == source.end()) {
+		DeleteSource(FindSource(sourceName));
+	}
+	//͓nhł͈ȂȂ (Xbgg񂵂ĂオႤ)
+	//CreateSourceAsync̓ǂݍ݂܂n܂ĂȂΑ҂ɕԂ (\[Xloader̃Xbhŏ)
+	void DeleteSource(SoundHandle handle)
+	{
+		SourceEntry* entry = sources.Get(handle);
+		if (entry == nullptr) {
 			return;
 		}
-		delete source[sourceName];
-		source.erase(sourceName);
+		updates.Forget(handle.index);
+		if (!entry->source->AbandonLoad()) {
+			delete entry->source;
+		}
+		sourceNames.erase(entry->name);
+		sourceIds.erase(entry->id);
+		sources.Remove(handle);
 	}
 	SoundSource* GetSource(const char* sourceName)
 	{
-		//\[X̑݃`FbN
-		if (source.find(sourceName) == source.end()) {
-			return nullptr;
+		return GetSource(FindSource(sourceName));
+	}
+	//ȃnh\[X̃nhȂnullptr
+	SoundSource* GetSource(SoundHandle handle)
+	{
+		SourceEntry* entry = sources.Get(handle);
+		return entry != nullptr ? entry->source : nullptr;
+	}
+	//OSoundId::Hash̒lnh (Ζȃnh)
+	//t[AǂݍݎɈxĎĂ
+	SoundHandle FindSource(const char* sourceName) const
+	{
+		auto it = sourceNames.find(sourceName);
+		return it != sourceNames.end() ? it->second : SoundHandle();
+	}
+	SoundHandle FindSource(std::uint32_t sourceId) const
+	{
+		auto it = sourceIds.find(sourceId);
+		return it != sourceIds.end() ? it->second : SoundHandle();
+	}
+	//c[̕\p (ȃnhȂnullptr)
+	const char* GetSourceName(SoundHandle handle)
+	{
+		SourceEntry* entry = sources.Get(handle);
+		return entry != nullptr ? entry->name.c_str() : nullptr;
+	}
+	size_t GetSourceCount() const
+	{
+		return sources.GetCount();
+	}
+	//handles[i]̃\[Ẍʒu(x[i], y[i], z[i])ɂ (t[S̔̂̒lnĂ悢)
+	//OƓl͎̂̂̂āAς̂FlushUpdatesł܂Ƃ߂AL֓n
+	//ȃnh\[X̃nh͖
+	void SetPositions(const SoundHandle* handles, const float* x, const float* y, const float* z, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (sources.Get(handles[i]) != nullptr)
+			{
+				updates.SetPosition(handles[i].index, x[i], y[i], z[i]);
+			}
+		}
+	}
+	void SetVelocities(const SoundHandle* handles, const float* x, const float* y, const float* z, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (sources.Get(handles[i]) != nullptr)
+			{
+				updates.SetVelocity(handles[i].index, x[i], y[i], z[i]);
+			}
+		}
+	}
+	void SetVolumes(const SoundHandle* handles, const float* volume, int count)
+	{
+		for (int i = 0; i < count; ++i)
+		{
+			if (sources.Get(handles[i]) != nullptr)
+			{
+				updates.SetVolume(handles[i].index, volume[i]);
+			}
+		}
+	}
+	//t[̍ŌɈxĂԁB߂ύX~LT[ɂ܂Ƃ߂ĔfAALɓnڐԂ
+	//z{CXgĂ΁Aŕ₷̂AL\[X蓖Ē
+	int FlushUpdates()
+	{
+		int applied = updates.Flush(context);
+		if (virtualVoices != nullptr)
+		{
+			virtualVoices->Update(context, GetMixedTime());
+		}
+		return applied;
+	}
+	//SetPositionsȂǂŎ󂯎ƁAlςĂȂĎ̂Ă
+	long long GetSubmittedUpdates() const
+	{
+		return updates.GetSubmitted();
+	}
+	long long GetCoalescedUpdates() const
+	{
+		return updates.GetCoalesced();
+	}
+	//PlayCopỹ{CXȂ̐U镑
+	void SetStealPolicy(VoicePool::StealPolicy policy)
+	{
+		voices->SetStealPolicy(policy);
+	}
+	//[vobNfoCXframes`悵bufferɏ (XeIȂ̂frames*2)
+	//[vobNŊJĂȂΉfalse
+	bool Render(short* buffer, int frames)
+	{
+		if (loopbackRate <= 0)
+		{
+			return false;
+		}
+		ALExtension::Get().alcRenderSamplesSOFT(device, buffer, frames);
+		renderedFrames += frames;
+		return true;
+	}
+	//foCXۂɕ`悵(b)
+	//[vobNRendert[Aʏ̃foCXALC_SOFT_device_clock狁߂ (΍Ă̎)
+	double GetMixedTime() const
+	{
+		if (loopbackRate > 0)
+		{
+			return (double)renderedFrames / loopbackRate;
+		}
+		ALExtension& ext = ALExtension::Get();
+		if (ext.hasDeviceClock)
+		{
+			ALCint64SOFT clock = 0;
+			ext.alcGetInteger64vSOFT(device, ALC_DEVICE_CLOCK_SOFT, 1, &clock);
+			return clock / 1000000000.0;
+		}
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+	}
+	//[vobNŊJgBsecondsbԂ҂ɕ`悵AXeI16bitWAVt@Cɏo
+	//chunkFramesƂɕ[̏ōς܂Ă`悵A`悵̂̂܂܃t@Cɏ̂ŁA
+	//`CPU邾i݁A茳Ɏ̂chunkFramesōς
+	//Xg[~Õ\[XchunkFramesL[̒(obt@̒~)ZΓr؂Ȃ
+	//[vobNłȂAoȂfalse
+	bool RenderToFile(const char* filePass, double seconds, int chunkFrames = 1024)
+	{
+		if (loopbackRate <= 0 || chunkFrames <= 0)
+		{
+			return false;
+		}
+		WavWriter writer;
+		if (!writer.Open(filePass, 2, 16, loopbackRate))
+		{
+			return false;
+		}
+		long long totalFrames = (long long)(seconds * loopbackRate);
+		std::vector<short> chunk((size_t)chunkFrames * 2);
+		for (long long done = 0; done < totalFrames;)
+		{
+			int frames = (int)std::min<long long>(chunkFrames, totalFrames - done);
+			//ǂ݂Î҂Ă[̂ŁA`̑ɓǂݍ݂ǂȂĂr؂Ȃ
+			prefetcher->WaitIdle();
+			scheduler->RunAll();
+			//z{CX`悵i߂Ă犄蓖Ē
+			if (virtualVoices != nullptr)
+			{
+				virtualVoices->Update(context, GetMixedTime());
+			}
+			Render(chunk.data(), frames);
+			if (!writer.Write(chunk.data(), frames))
+			{
+				return false;
+			}
+			done += frames;
 		}
-		return source[sourceName];
+		return writer.Close();
+	}
+	int GetLoopbackRate() const
+	{
+		return loopbackRate;
+	}
+	//S\[X̃A_[̍vB\[Ẍꗗ⃍bNɐGȂ̂ŊĎXbhpɂɌĂł悢
+	SoundStats::Snapshot GetStats() const
+	{
+		return stats.GetSnapshot();
 	}
 
 };
\ No newline at end of file
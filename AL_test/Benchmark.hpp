@@ -0,0 +1,1138 @@
+#pragma once
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <algorithm>
+#ifndef _WIN32
+#include <sys/resource.h>
+#endif
+#include "Audio.hpp"
+#include "PackedBankBuilder.hpp"
+
+//vʂ@Bœǂ߂`(JSON)ŏo͂邽߂̓ꕨ
+//ZNV͍ŏɒǉꂽAڂ͒ǉɕׂ
+class BenchmarkReport
+{
+private:
+	struct Entry
+	{
+		std::string section;
+		std::string key;
+		//JSONƂďo͍ς݂̒l
+		std::string value;
+	};
+	std::vector<Entry> entries_;
+public:
+	void Add(const std::string& section, const std::string& key, double value)
+	{
+		//JSONɂNaN△傪̂nullɂ
+		if (!std::isfinite(value))
+		{
+			entries_.push_back({ section, key, "null" });
+			return;
+		}
+		std::ostringstream stream;
+		stream.precision(9);
+		stream << value;
+		entries_.push_back({ section, key, stream.str() });
+	}
+	void Add(const std::string& section, const std::string& key, const std::string& text)
+	{
+		entries_.push_back({ section, key, Quote(text) });
+	}
+	void AddBool(const std::string& section, const std::string& key, bool value)
+	{
+		entries_.push_back({ section, key, value ? "true" : "false" });
+	}
+	void Print(std::ostream& os) const
+	{
+		std::vector<std::string> sections;
+		for (auto& entry : entries_)
+		{
+			if (std::find(sections.begin(), sections.end(), entry.section) == sections.end())
+			{
+				sections.push_back(entry.section);
+			}
+		}
+		os << "{" << std::endl;
+		for (size_t i = 0; i < sections.size(); ++i)
+		{
+			os << "  " << Quote(sections[i]) << ": {";
+			bool isFirst = true;
+			for (auto& entry : entries_)
+			{
+				if (entry.section != sections[i])
+				{
+					continue;
+				}
+				os << (isFirst ? "" : ",") << std::endl << "    " << Quote(entry.key) << ": " << entry.value;
+				isFirst = false;
+			}
+			os << std::endl << "  }" << (i + 1 < sections.size() ? "," : "") << std::endl;
+		}
+		os << "}" << std::endl;
+	}
+private:
+	static std::string Quote(const std::string& text)
+	{
+		std::string result = "\"";
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				result += '\\';
+				result += c;
+			}
+			else if ((unsigned char)c < 0x20)
+			{
+				char escape[8];
+				snprintf(escape, sizeof(escape), "\\u%04x", c);
+				result += escape;
+			}
+			else
+			{
+				result += c;
+			}
+		}
+		return result + "\"";
+	}
+};
+
+//R}hCĂԌvp̃hCo[
+//AL_test bench <> [...] ̌`ŌĂяo
+class SoundBenchmark
+{
+public:
+	static int Run(int argc, char* argv[])
+	{
+		if (argc < 3)
+		{
+			PrintUsage();
+			return 1;
+		}
+		std::string name = argv[2];
+		if (name == "scheduler")
+		{
+			return Scheduler(argc - 3, argv + 3);
+		}
+		if (name == "decode")
+		{
+			return Decode(argc - 3, argv + 3);
+		}
+		if (name == "convert")
+		{
+			return Convert(argc - 3, argv + 3);
+		}
+		if (name == "mixer")
+		{
+			return Mixer(argc - 3, argv + 3);
+		}
+		if (name == "resample")
+		{
+			return Resample(argc - 3, argv + 3);
+		}
+		if (name == "adpcm")
+		{
+			return Adpcm(argc - 3, argv + 3);
+		}
+		if (name == "offline")
+		{
+			return Offline(argc - 3, argv + 3);
+		}
+		if (name == "bank")
+		{
+			return Bank(argc - 3, argv + 3);
+		}
+		if (name == "packed")
+		{
+			return Packed(argc - 3, argv + 3);
+		}
+		if (name == "virtual")
+		{
+			return Virtual(argc - 3, argv + 3);
+		}
+		if (name == "suite")
+		{
+			return Suite(argc - 3, argv + 3);
+		}
+		PrintUsage();
+		return 1;
+	}
+private:
+	static void PrintUsage()
+	{
+		std::cout << "usage: AL_test bench scheduler <wav> [numSource=200] [seconds=5]" << std::endl;
+		std::cout << "       AL_test bench decode <wav|ogg> [seconds=5]" << std::endl;
+		std::cout << "       AL_test bench convert [frames=65536] [seconds=1]" << std::endl;
+		std::cout << "       AL_test bench mixer <wav|ogg> [voices=1024] [seconds=1]" << std::endl;
+		std::cout << "       AL_test bench resample [inRate=44100] [outRate=48000] [seconds=1]" << std::endl;
+		std::cout << "       AL_test bench adpcm <wav|ogg> [seconds=1]" << std::endl;
+		std::cout << "       AL_test bench offline <wav|ogg> [seconds=60] [out=offline.wav] [rate=48000]" << std::endl;
+		std::cout << "       AL_test bench bank <manifest> [numLoadThread=4] [batch=16]" << std::endl;
+		std::cout << "       AL_test bench packed <directory> [out=bench.sbk] [numLoadThread=4]" << std::endl;
+		std::cout << "       AL_test bench virtual <wav|ogg> [numEmitter=10000] [numReal=64] [frames=600]" << std::endl;
+		std::cout << "       AL_test bench suite <wav|ogg> [numSource=32] [audioSeconds=10] [rate=48000]" << std::endl;
+	}
+	//vZX̃Xbh (擾łȂł-1)
+	static int GetThreadCount()
+	{
+#ifdef __linux__
+		std::ifstream status("/proc/self/status");
+		std::string line;
+		while (std::getline(status, line))
+		{
+			if (line.compare(0, 8, "Threads:") == 0)
+			{
+				return std::atoi(line.c_str() + 8);
+			}
+		}
+#endif
+		return -1;
+	}
+	//vZX̗ݐσReLXgXCb` (擾łȂł-1)
+	static long long GetContextSwitches()
+	{
+#ifndef _WIN32
+		rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+			return (long long)usage.ru_nvcsw + usage.ru_nivcsw;
+		}
+#endif
+		return -1;
+	}
+	//vZXŜŎgCPU (擾łȂł-1)
+	static double GetProcessCpuSeconds()
+	{
+#ifndef _WIN32
+		rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0)
+		{
+			return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+		}
+#endif
+		return -1.0;
+	}
+	//ĂяoXbhgCPU (擾łȂł-1)
+	static double GetThreadCpuSeconds()
+	{
+#ifdef __linux__
+		rusage usage;
+		if (getrusage(RUSAGE_THREAD, &usage) == 0)
+		{
+			return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+		}
+#endif
+		return -1.0;
+	}
+	//values[0..1]̈ʒu̒l (ȂNaN)
+	static double Percentile(std::vector<double> values, double rate)
+	{
+		if (values.empty())
+		{
+			return NAN;
+		}
+		std::sort(values.begin(), values.end());
+		size_t index = (size_t)(rate * (values.size() - 1) + 0.5);
+		return values[index];
+	}
+	static double Mean(const std::vector<double>& values)
+	{
+		if (values.empty())
+		{
+			return NAN;
+		}
+		double sum = 0.0;
+		for (double value : values)
+		{
+			sum += value;
+		}
+		return sum / values.size();
+	}
+	static double ElapsedSeconds(std::chrono::steady_clock::time_point begin)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+	}
+	//\[XƂɃXPW[[ꍇ(]̃Xbh1{/\[X)
+	//SoundClass̋LXPW[[gꍇ̃XbhƃReLXgXCb`ׂ
+	static int Scheduler(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		int numSource = argc > 1 ? std::atoi(argv[1]) : 200;
+		int seconds = argc > 2 ? std::atoi(argv[2]) : 5;
+
+		SoundClass sound;
+		for (int shared = 0; shared < 2; ++shared)
+		{
+			SoundScheduler sharedScheduler;
+			WorkerPool sharedIo(1);
+			SoundEnvironment environment = {};
+			environment.scheduler = shared ? &sharedScheduler : nullptr;
+			environment.io = shared ? &sharedIo : nullptr;
+			std::vector<SoundSource*> sources;
+			for (int i = 0; i < numSource; ++i)
+			{
+				sources.push_back(new SoundSource(filePass, SoundSource::LoadMode::Streaming, 32, &environment));
+				sources.back()->Play(true);
+			}
+
+			int threads = GetThreadCount();
+			long long switches = GetContextSwitches();
+			auto begin = std::chrono::steady_clock::now();
+			std::this_thread::sleep_for(std::chrono::seconds(seconds));
+			double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+			long long switchesEnd = GetContextSwitches();
+
+			std::cout << (shared ? "shared" : "per-source") << " scheduler" << std::endl;
+			std::cout << "  sources            = " << numSource << std::endl;
+			std::cout << "  threads            = " << threads << std::endl;
+			if (switches >= 0)
+			{
+				std::cout << "  context switches/s = " << (switchesEnd - switches) / elapsed << std::endl;
+			}
+
+			for (auto source : sources)
+			{
+				delete source;
+			}
+		}
+		return 0;
+	}
+	//IAudioData1XbhŐ擪I[܂œǂݑA1RÃfR[hx𑪂
+	static int Decode(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		int seconds = argc > 1 ? std::atoi(argv[1]) : 5;
+
+		AudioDataFactory factory;
+		IAudioData* audio = factory.Create(filePass);
+		if (audio == nullptr)
+		{
+			std::cout << "not support " << filePass << std::endl;
+			return 1;
+		}
+		int channels = SoundFormatInfo::GetChannels(audio->GetFormat());
+		std::vector<char> buffer(4096 * audio->GetBlockSize());
+
+		long long frames = 0;
+		auto begin = std::chrono::steady_clock::now();
+		double elapsed = 0.0;
+		while (elapsed < seconds)
+		{
+			audio->Seek(0);
+			int readSize;
+			while ((readSize = audio->Read(buffer.data(), (int)buffer.size())) > 0)
+			{
+				frames += readSize / audio->GetBlockSize();
+			}
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		}
+
+		std::cout << "decode " << filePass << std::endl;
+		std::cout << "  sampling rate        = " << audio->GetSamplingRate() << "\t[Hz]" << std::endl;
+		std::cout << "  channels             = " << channels << std::endl;
+		std::cout << "  frames/s per core    = " << frames / elapsed << std::endl;
+		std::cout << "  samples/s per core   = " << frames * channels / elapsed << std::endl;
+		std::cout << "  realtime factor      = " << frames / elapsed / audio->GetSamplingRate() << std::endl;
+		delete audio;
+		return 0;
+	}
+	//wbJԂA1bɏłTvԂ
+	static double MeasureSamples(const std::function<void()>& func, size_t samples, double seconds)
+	{
+		long long count = 0;
+		auto begin = std::chrono::steady_clock::now();
+		double elapsed = 0.0;
+		while (elapsed < seconds)
+		{
+			func();
+			++count;
+			elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		}
+		return count * (double)samples / elapsed;
+	}
+	//SampleConverter̊eϊ𖽗߃ZbgƂɑAwav.cppŎgĂ1Tv̃[vƔׂ
+	static int Convert(int argc, char* argv[])
+	{
+		size_t frames = argc > 0 ? (size_t)std::atoll(argv[0]) : 65536;
+		double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+		if (frames == 0)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		//XeÏ̗pӂĎg
+		std::vector<std::uint8_t> u8(2 * frames);
+		std::vector<std::int16_t> s16(2 * frames);
+		std::vector<std::int16_t> ch0(frames);
+		std::vector<std::int16_t> ch1(frames);
+		std::vector<float> f32(2 * frames);
+		for (size_t i = 0; i < 2 * frames; ++i)
+		{
+			u8[i] = (std::uint8_t)(i * 7);
+			s16[i] = (std::int16_t)(i * 977);
+			f32[i] = (float)(i % 2001) / 1000.0f - 1.0f;
+		}
+
+		struct Kernel
+		{
+			const char* name;
+			size_t samples;
+			std::function<void()> legacy;
+			std::function<void()> convert;
+		};
+		std::vector<Kernel> kernels = {
+			{ "u8->s16", 2 * frames,
+				[&] { for (size_t t = 0; t < 2 * frames; t++) s16[t] = (short(u8[t]) - 0x80) << 8; },
+				[&] { SampleConverter::U8ToS16(u8.data(), s16.data(), 2 * frames); } },
+			{ "s16->u8", 2 * frames,
+				[&] { for (size_t t = 0; t < 2 * frames; t++) u8[t] = (s16[t] >> 8) + 0x80; },
+				[&] { SampleConverter::S16ToU8(s16.data(), u8.data(), 2 * frames); } },
+			{ "s16->f32", 2 * frames,
+				nullptr,
+				[&] { SampleConverter::S16ToF32(s16.data(), f32.data(), 2 * frames); } },
+			{ "f32->s16", 2 * frames,
+				nullptr,
+				[&] { SampleConverter::F32ToS16(f32.data(), s16.data(), 2 * frames); } },
+			{ "interleave", 2 * frames,
+				[&] { for (size_t t = 0; t < frames; t++) { s16[2 * t] = ch0[t]; s16[2 * t + 1] = ch1[t]; } },
+				[&] { SampleConverter::InterleaveS16(ch0.data(), ch1.data(), s16.data(), frames); } },
+			{ "deinterleave", 2 * frames,
+				[&] { for (size_t t = 0; t < frames; t++) { ch0[t] = s16[2 * t]; ch1[t] = s16[2 * t + 1]; } },
+				[&] { SampleConverter::DeinterleaveS16(s16.data(), ch0.data(), ch1.data(), frames); } },
+			{ "downmix", 2 * frames,
+				nullptr,
+				[&] { SampleConverter::DownmixS16(s16.data(), ch0.data(), frames); } },
+		};
+
+		SampleConverter::Isa supported = SampleConverter::GetSupportedIsa();
+		std::cout << "convert " << frames << " frames (stereo)" << std::endl;
+		std::cout << "  supported isa = " << SampleConverter::GetIsaName(supported) << std::endl;
+		for (auto& kernel : kernels)
+		{
+			std::cout << "  " << kernel.name << std::endl;
+			double base = 0.0;
+			if (kernel.legacy)
+			{
+				base = MeasureSamples(kernel.legacy, kernel.samples, seconds);
+				std::cout << "    loop   = " << base / 1e6 << "\t[Msamples/s]" << std::endl;
+			}
+			for (int isa = 0; isa <= (int)supported; ++isa)
+			{
+				SampleConverter::SetIsa((SampleConverter::Isa)isa);
+				const char* isaName = SampleConverter::GetIsaName((SampleConverter::Isa)isa);
+				double rate = MeasureSamples(kernel.convert, kernel.samples, seconds);
+				std::cout << "    " << isaName << std::string(6 - strlen(isaName), ' ') << " = " << rate / 1e6 << "\t[Msamples/s]";
+				if (base > 0.0)
+				{
+					std::cout << "\t(x" << rate / base << ")";
+				}
+				std::cout << std::endl;
+			}
+		}
+		SampleConverter::SetIsa(supported);
+		return 0;
+	}
+	//SoftwareMixervoices[vĐA48kHz1RA{CX܂ŎԂō邩𖽗߃ZbgƂɑ
+	//~bNX̎Ԃ͎gɈ˂Ȃ̂ŁAt@C̎gɊ֌WȂ48kHzƂēo^
+	static int Mixer(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		int numVoice = argc > 1 ? std::atoi(argv[1]) : 1024;
+		double seconds = argc > 2 ? std::atof(argv[2]) : 1.0;
+		const int rate = 48000;
+		//̃~bNX̒ (48kHzŖ10ms)
+		const int mixFrames = 480;
+		if (numVoice <= 0)
+		{
+			PrintUsage();
+			return 1;
+		}
+
+		AudioDataFactory factory;
+		IAudioData* audio = factory.Create(filePass);
+		if (audio == nullptr)
+		{
+			std::cout << "not support " << filePass << std::endl;
+			return 1;
+		}
+		std::vector<char> pcm(audio->GetPcmSize() * audio->GetBlockSize());
+		audio->Seek(0);
+		int readSize = 0;
+		int singleReadSize;
+		while (readSize != (int)pcm.size() && (singleReadSize = audio->Read(pcm.data() + readSize, (int)pcm.size() - readSize)) > 0)
+		{
+			readSize += singleReadSize;
+		}
+		SoundFormat format = audio->GetFormat();
+		int channels = SoundFormatInfo::GetChannels(format);
+		int bits = SoundFormatInfo::GetBits(format);
+		int frames = readSize / audio->GetBlockSize();
+		delete audio;
+
+		std::vector<std::int16_t> out(mixFrames * 2);
+		SampleConverter::Isa supported = SampleConverter::GetSupportedIsa();
+		std::cout << "mixer " << filePass << std::endl;
+		std::cout << "  voices        = " << numVoice << std::endl;
+		std::cout << "  supported isa = " << SampleConverter::GetIsaName(supported) << std::endl;
+		for (int isa = 0; isa <= (int)supported; ++isa)
+		{
+			SampleConverter::SetIsa((SampleConverter::Isa)isa);
+			SoftwareMixer mixer(rate, numVoice);
+			int sound = mixer.AddSound(pcm.data(), frames, channels, bits, rate);
+			if (sound < 0)
+			{
+				std::cout << "not support " << filePass << std::endl;
+				return 1;
+			}
+			//n߂̈ʒuȂ悤ɏ炵đĂ
+			for (int i = 0; i < numVoice; ++i)
+			{
+				mixer.Play(sound, 1.0f / numVoice, (i % 21) / 10.0f - 1.0f, true);
+				if (i % 64 == 63)
+				{
+					mixer.Mix(out.data(), 1);
+				}
+			}
+			mixer.Mix(out.data(), mixFrames);
+
+			double framesPerSec = MeasureSamples([&] { mixer.Mix(out.data(), mixFrames); }, mixFrames, seconds);
+			double realtime = framesPerSec / rate;
+			const char* isaName = SampleConverter::GetIsaName((SampleConverter::Isa)isa);
+			std::cout << "  " << isaName << std::endl;
+			std::cout << "    realtime factor = " << realtime << std::endl;
+			std::cout << "    voices/core     = " << realtime * mixer.GetNumActive() << "\t(48kHz)" << std::endl;
+		}
+		SampleConverter::SetIsa(supported);
+		return 0;
+	}
+	//ResamplerŎgϊA1`l1b̕ϊɂ鎞Ԃ𖽗߃ZbgƂɑ
+	//ǂݍݎɕϊ鎞̈x̎ԂŁAĐOpenAL񕥂ϊ̑ɂȂ
+	static int Resample(int argc, char* argv[])
+	{
+		int inRate = argc > 0 ? std::atoi(argv[0]) : 44100;
+		int outRate = argc > 1 ? std::atoi(argv[1]) : 48000;
+		double seconds = argc > 2 ? std::atof(argv[2]) : 1.0;
+		//ɓn (Xg[~Õobt@1x)
+		const int chunkFrames = 1024;
+		if (!Resampler::IsSupported(inRate, outRate, 2))
+		{
+			std::cout << "not support " << inRate << " -> " << outRate << std::endl;
+			return 1;
+		}
+
+		//XeĨTCg
+		std::vector<std::int16_t> in(chunkFrames * 2);
+		for (int i = 0; i < chunkFrames; ++i)
+		{
+			in[2 * i] = (std::int16_t)(12000.0 * std::sin(i * 0.05));
+			in[2 * i + 1] = (std::int16_t)(12000.0 * std::sin(i * 0.11));
+		}
+
+		SampleConverter::Isa supported = SampleConverter::GetSupportedIsa();
+		std::cout << "resample " << inRate << " -> " << outRate << " (stereo)" << std::endl;
+		std::cout << "  supported isa = " << SampleConverter::GetIsaName(supported) << std::endl;
+		for (int isa = 0; isa <= (int)supported; ++isa)
+		{
+			SampleConverter::SetIsa((SampleConverter::Isa)isa);
+			Resampler resampler(inRate, outRate, 2);
+			std::vector<std::int16_t> out(resampler.GetMaxOutputFrames(chunkFrames) * 2);
+			if (isa == 0)
+			{
+				std::cout << "  taps/phase    = " << resampler.GetTaps() << std::endl;
+			}
+			double framesPerSec = MeasureSamples([&] { resampler.Process(in.data(), chunkFrames, out.data()); }, chunkFrames, seconds);
+			double channelSeconds = framesPerSec * 2 / inRate;
+			const char* isaName = SampleConverter::GetIsaName((SampleConverter::Isa)isa);
+			std::cout << "  " << isaName << std::endl;
+			std::cout << "    channel-seconds/s  = " << channelSeconds << std::endl;
+			std::cout << "    ms/channel-second  = " << 1000.0 / channelSeconds << std::endl;
+		}
+		SampleConverter::SetIsa(supported);
+		return 0;
+	}
+	//[vobNŃt@C[vĐAsecondsbRenderToFileŏôɂԂ𑪂
+	//Ԃ̉{ŕ`łôŁACIł܂Ƃ߂ďo̖ڈɂ
+	static int Offline(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		double seconds = argc > 1 ? std::atof(argv[1]) : 60.0;
+		const char* outPass = argc > 2 ? argv[2] : "offline.wav";
+		int rate = argc > 3 ? std::atoi(argv[3]) : 48000;
+
+		SoundClass sound(1, 64, 2, rate);
+		SoundSource* source = sound.GetSource(sound.CreateSourceHandle("offline", filePass, SoundSource::LoadMode::Streaming));
+		if (source == nullptr)
+		{
+			std::cout << "can't load " << filePass << std::endl;
+			return 1;
+		}
+		source->Play(true);
+
+		auto begin = std::chrono::steady_clock::now();
+		bool isWritten = sound.RenderToFile(outPass, seconds);
+		double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+		if (!isWritten)
+		{
+			std::cout << "can't write " << outPass << std::endl;
+			return 1;
+		}
+		SoundStats::Snapshot stats = sound.GetStats();
+		std::cout << "offline " << filePass << " -> " << outPass << std::endl;
+		std::cout << "  audio seconds  = " << seconds << std::endl;
+		std::cout << "  wall seconds   = " << elapsed << std::endl;
+		std::cout << "  x realtime     = " << (elapsed > 0.0 ? seconds / elapsed : 0.0) << std::endl;
+		std::cout << "  underruns      = " << stats.underruns << std::endl;
+		return 0;
+	}
+	//ꗗ̃t@C]ʂCreateSource1ǂ񂾏ꍇƁALoadBankł܂Ƃ߂ēǂ񂾏ꍇ̎Ԃׂ
+	//ɓǂޕOS̃t@CLbV܂̂ŁALoadBank̕LɂȂ_ɒ
+	static int Bank(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* manifestPass = argv[0];
+		int numLoadThread = argc > 1 ? std::atoi(argv[1]) : 4;
+		int batchSize = argc > 2 ? std::atoi(argv[2]) : 16;
+
+		std::vector<SoundBankEntry> manifest;
+		if (!SoundBankEntry::ReadManifest(manifestPass, &manifest))
+		{
+			std::cout << "can't read " << manifestPass << std::endl;
+			return 1;
+		}
+
+		double sequentialMs = 0.0;
+		int numSequential = 0;
+		{
+			SoundClass sound(1, 64, numLoadThread);
+			auto begin = std::chrono::steady_clock::now();
+			for (const SoundBankEntry& entry : manifest)
+			{
+				try
+				{
+					if (sound.CreateSource(entry.name.c_str(), entry.filePass.c_str(), entry.mode, entry.config))
+					{
+						++numSequential;
+					}
+				}
+				catch (...)
+				{
+				}
+			}
+			sequentialMs = ElapsedSeconds(begin) * 1000.0;
+		}
+
+		SoundBankReport report;
+		{
+			SoundClass sound(1, 64, numLoadThread);
+			sound.LoadBank(manifest, &report, batchSize);
+		}
+
+		std::vector<double> readMs;
+		std::vector<double> uploadMs;
+		long long bufferBytes = 0;
+		std::cout << "bank " << manifestPass << " (" << manifest.size() << " files, " << numLoadThread << " threads, batch " << batchSize << ")" << std::endl;
+		std::cout << "  name\twait[ms]\tread[ms]\tupload[ms]\tbytes" << std::endl;
+		for (const SoundBankReport::File& file : report.files)
+		{
+			std::cout << "  " << file.name << "\t" << file.waitMs << "\t" << file.readMs << "\t" << file.uploadMs << "\t" << file.bufferBytes << (file.isLoaded ? "" : "\t(failed)") << std::endl;
+			if (file.isLoaded)
+			{
+				readMs.push_back(file.readMs);
+				uploadMs.push_back(file.uploadMs);
+				bufferBytes += file.bufferBytes;
+			}
+		}
+		std::cout << "  sequential     = " << sequentialMs << "\t[ms]\t(" << numSequential << " loaded)" << std::endl;
+		std::cout << "  bank total     = " << report.totalMs << "\t[ms]\t(" << report.numLoaded << " loaded)" << std::endl;
+		std::cout << "  bank upload    = " << report.uploadMs << "\t[ms]\t(" << report.numBatch << " batches)" << std::endl;
+		std::cout << "  read p50/p99   = " << Percentile(readMs, 0.5) << " / " << Percentile(readMs, 0.99) << "\t[ms]" << std::endl;
+		std::cout << "  upload p50/p99 = " << Percentile(uploadMs, 0.5) << " / " << Percentile(uploadMs, 0.99) << "\t[ms]" << std::endl;
+		std::cout << "  buffer bytes   = " << bufferBytes << std::endl;
+		return 0;
+	}
+	//tH_.wavʂ̃t@Ĉ܂LoadBankœǂ񂾏ꍇƁAoNɂ܂Ƃ߂LoadPackedBankœǂ񂾏ꍇׂ
+	//ǂAllReadŁAɌʂ̃t@Cǂނ̂OS̃t@CLbV͉܂ԂŔׂ邱ƂɂȂ
+	static int Packed(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* directory = argv[0];
+		const char* bankPass = argc > 1 ? argv[1] : "bench.sbk";
+		int numLoadThread = argc > 2 ? std::atoi(argv[2]) : 4;
+
+		std::vector<SoundBankEntry> entries;
+		PackedBankBuilder::CollectWaves(directory, &entries);
+		auto begin = std::chrono::steady_clock::now();
+		std::string message;
+		if (!PackedBankBuilder::Build(entries, bankPass, &message))
+		{
+			std::cout << message << std::endl;
+			return 1;
+		}
+		double buildMs = ElapsedSeconds(begin) * 1000.0;
+
+		SoundBankReport files;
+		{
+			SoundClass sound(1, 64, numLoadThread);
+			sound.LoadBank(entries, &files);
+		}
+		SoundBankReport packed;
+		{
+			SoundClass sound(1, 64, numLoadThread);
+			sound.LoadPackedBank(bankPass, SoundSource::LoadMode::AllRead, &packed);
+		}
+		std::vector<double> filesRead;
+		std::vector<double> packedRead;
+		for (const SoundBankReport::File& file : files.files)
+		{
+			filesRead.push_back(file.readMs);
+		}
+		for (const SoundBankReport::File& file : packed.files)
+		{
+			packedRead.push_back(file.readMs);
+		}
+		std::cout << "packed " << directory << " -> " << bankPass << " (" << entries.size() << " files, " << numLoadThread << " threads)" << std::endl;
+		std::cout << "  build          = " << buildMs << "\t[ms]" << std::endl;
+		std::cout << "  files total    = " << files.totalMs << "\t[ms]\t(" << files.numLoaded << " loaded)" << std::endl;
+		std::cout << "  packed total   = " << packed.totalMs << "\t[ms]\t(" << packed.numLoaded << " loaded)" << std::endl;
+		std::cout << "  files read p50/p99  = " << Percentile(filesRead, 0.5) << " / " << Percentile(filesRead, 0.99) << "\t[ms]" << std::endl;
+		std::cout << "  packed read p50/p99 = " << Percentile(packedRead, 0.5) << " / " << Percentile(packedRead, 0.99) << "\t[ms]" << std::endl;
+		return 0;
+	}
+	//numEmitterAllRead̃\[Xz{CXɂă[vĐA񂳂ȂframesFlushUpdatesƕ`JԂ
+	//AL\[XnumReal̂ŁAt[₷Ɋ蓖Ē̎ԂƓւ̐𑪂
+	static int Virtual(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		int numEmitter = argc > 1 ? std::atoi(argv[1]) : 10000;
+		int numReal = argc > 2 ? std::atoi(argv[2]) : 64;
+		int frames = argc > 3 ? std::atoi(argv[3]) : 600;
+		const int rate = 48000;
+		const int renderFrames = rate / 60;
+
+		SoundClass sound(1, 64, 2, rate);
+		sound.SetVirtualVoices(true, numReal);
+		auto begin = std::chrono::steady_clock::now();
+		std::vector<SoundHandle> handles;
+		for (int i = 0; i < numEmitter; ++i)
+		{
+			SoundHandle handle = sound.CreateSourceHandle(("emitter" + std::to_string(i)).c_str(), filePass, SoundSource::LoadMode::AllRead);
+			SoundSource* source = sound.GetSource(handle);
+			if (source == nullptr)
+			{
+				std::cout << "can't load " << filePass << std::endl;
+				return 1;
+			}
+			source->Play(true);
+			handles.push_back(handle);
+		}
+		double createMs = ElapsedSeconds(begin) * 1000.0;
+
+		//̂͌_̎𔼌a1`100łꂼႤŉ
+		std::vector<float> x(numEmitter), y(numEmitter, 0.0f), z(numEmitter);
+		std::vector<short> mix((size_t)renderFrames * 2);
+		std::vector<double> flushMs;
+		long long bindBegin = sound.GetVirtualVoices()->GetNumBind();
+		for (int frame = 0; frame < frames; ++frame)
+		{
+			for (int i = 0; i < numEmitter; ++i)
+			{
+				float radius = 1.0f + (i % 100);
+				float angle = frame * 0.01f * (1 + i % 7) + i;
+				x[i] = radius * std::cos(angle);
+				z[i] = radius * std::sin(angle);
+			}
+			sound.SetPositions(handles.data(), x.data(), y.data(), z.data(), numEmitter);
+			auto flushBegin = std::chrono::steady_clock::now();
+			sound.FlushUpdates();
+			flushMs.push_back(ElapsedSeconds(flushBegin) * 1000.0);
+			sound.Render(mix.data(), renderFrames);
+		}
+		VirtualVoicePool* pool = sound.GetVirtualVoices();
+		long long binds = pool->GetNumBind() - bindBegin;
+		std::cout << "virtual " << filePass << " (" << numEmitter << " emitters, " << pool->GetNumRealVoice() << " real voices, " << frames << " frames)" << std::endl;
+		std::cout << "  create         = " << createMs << "\t[ms]" << std::endl;
+		std::cout << "  flush p50/p99  = " << Percentile(flushMs, 0.5) << " / " << Percentile(flushMs, 0.99) << "\t[ms]" << std::endl;
+		std::cout << "  playing        = " << pool->GetNumPlaying() << std::endl;
+		std::cout << "  binds / frame  = " << (frames > 0 ? (double)binds / frames : 0.0) << std::endl;
+		return 0;
+	}
+	//t@CIMA ADPCMɂ̑傫Ɨ(SN)Aƕ̑𑪂
+	//AllRead̃obt@kĎɏ풓ǂꂾ邩̖ڈɂ
+	static int Adpcm(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		double seconds = argc > 1 ? std::atof(argv[1]) : 1.0;
+
+		AudioDataFactory factory;
+		IAudioData* audio = factory.Create(filePass);
+		if (audio == nullptr)
+		{
+			std::cout << "not support " << filePass << std::endl;
+			return 1;
+		}
+		std::vector<char> pcm(audio->GetPcmSize() * audio->GetBlockSize());
+		audio->Seek(0);
+		int readSize = 0;
+		int singleReadSize;
+		while (readSize != (int)pcm.size() && (singleReadSize = audio->Read(pcm.data() + readSize, (int)pcm.size() - readSize)) > 0)
+		{
+			readSize += singleReadSize;
+		}
+		SoundFormat format = audio->GetFormat();
+		int channels = SoundFormatInfo::GetChannels(format);
+		int frames = readSize / audio->GetBlockSize();
+		delete audio;
+
+		//8bitfloat16bitɂĂׂ
+		std::vector<std::int16_t> work;
+		const std::int16_t* pcm16 = SoundFormatInfo::ToS16(pcm.data(), (size_t)frames * channels, format, &work);
+		std::vector<std::int16_t> source(pcm16, pcm16 + (size_t)frames * channels);
+		std::vector<char> encoded;
+		ImaAdpcm::Encode(source.data(), frames, channels, &encoded);
+		std::vector<std::int16_t> decoded;
+		ImaAdpcm::Decode(encoded.data(), (int)encoded.size(), channels, &decoded);
+		double signal = 0.0;
+		double noise = 0.0;
+		for (size_t i = 0; i < source.size(); ++i)
+		{
+			double error = (double)decoded[i] - source[i];
+			signal += (double)source[i] * source[i];
+			noise += error * error;
+		}
+
+		size_t samples = source.size();
+		double encodeRate = MeasureSamples([&] { ImaAdpcm::Encode(source.data(), frames, channels, &encoded); }, samples, seconds);
+		double decodeRate = MeasureSamples([&] { ImaAdpcm::Decode(encoded.data(), (int)encoded.size(), channels, &decoded); }, samples, seconds);
+		std::cout << "adpcm " << filePass << std::endl;
+		std::cout << "  pcm16 bytes   = " << source.size() * sizeof(std::int16_t) << std::endl;
+		std::cout << "  ima4 bytes    = " << encoded.size() << "\t(x" << (double)source.size() * sizeof(std::int16_t) / encoded.size() << ")" << std::endl;
+		std::cout << "  snr           = " << (noise > 0.0 ? 10.0 * std::log10(signal / noise) : 0.0) << "\t[dB]" << std::endl;
+		std::cout << "  encode        = " << encodeRate / 1e6 << "\t[Msamples/s]" << std::endl;
+		std::cout << "  decode        = " << decodeRate / 1e6 << "\t[Msamples/s]" << std::endl;
+		return 0;
+	}
+	//ALC_SOFT_loopback̃foCXԂ҂ɕ`悵ASoundClassSoundSource܂Ƃ߂đ
+	//foCX̖LinuxCIłAʂJSONŕWo͂ɏo
+	static int Suite(int argc, char* argv[])
+	{
+		if (argc < 1)
+		{
+			PrintUsage();
+			return 1;
+		}
+		const char* filePass = argv[0];
+		int numSource = argc > 1 ? std::atoi(argv[1]) : 32;
+		double audioSeconds = argc > 2 ? std::atof(argv[2]) : 10.0;
+		int rate = argc > 3 ? std::atoi(argv[3]) : 48000;
+		//̕`̒ (48kHzŖ21ms)
+		const int renderFrames = 1024;
+
+		BenchmarkReport report;
+		report.Add("meta", "benchmark", "suite");
+		report.Add("meta", "file", filePass);
+		report.Add("meta", "sources", numSource);
+		report.Add("meta", "audio_seconds", audioSeconds);
+		report.Add("meta", "rate", rate);
+		report.Add("meta", "render_frames", renderFrames);
+		try
+		{
+			SoundClass sound(1, 64, 2, rate);
+			ALExtension& ext = ALExtension::Get();
+			const char* version = alGetString(AL_VERSION);
+			const char* renderer = alGetString(AL_RENDERER);
+			report.Add("meta", "al_version", version != nullptr ? version : "");
+			report.Add("meta", "al_renderer", renderer != nullptr ? renderer : "");
+			report.AddBool("meta", "events", ext.hasEvents);
+			report.AddBool("meta", "source_latency", ext.hasSourceLatency);
+			report.Add("meta", "isa", SampleConverter::GetIsaName(SampleConverter::GetIsa()));
+
+			SuiteLoad(sound, filePass, numSource, &report);
+			SuiteStreaming(sound, numSource, audioSeconds, renderFrames, &report);
+			AddStats(sound.GetStats(), "stats", &report);
+			SuitePlayCopy(filePass, &report);
+		}
+		catch (const char* message)
+		{
+			report.Add("meta", "error", message);
+			report.Print(std::cout);
+			return 1;
+		}
+		catch (const std::string& message)
+		{
+			report.Add("meta", "error", message);
+			report.Print(std::cout);
+			return 1;
+		}
+		report.Print(std::cout);
+		return 0;
+	}
+	//ǂݍ݂̃Xg[~O\[XƁA񓯊ǂݍ݂̃I[[h\[XnumSource鎞
+	//Xg[~O\[X"stream0"`̖OŎcAvŎg
+	static void SuiteLoad(SoundClass& sound, const char* filePass, int numSource, BenchmarkReport* report)
+	{
+		auto begin = std::chrono::steady_clock::now();
+		for (int i = 0; i < numSource; ++i)
+		{
+			sound.CreateSource(("stream" + std::to_string(i)).c_str(), filePass, SoundSource::LoadMode::Streaming);
+		}
+		double streamingSeconds = ElapsedSeconds(begin);
+
+		begin = std::chrono::steady_clock::now();
+		std::vector<std::shared_future<bool>> results;
+		for (int i = 0; i < numSource; ++i)
+		{
+			results.push_back(sound.CreateSourceAsync(("allread" + std::to_string(i)).c_str(), filePass, SoundSource::LoadMode::AllRead));
+		}
+		int failed = 0;
+		for (auto& result : results)
+		{
+			failed += result.get() ? 0 : 1;
+		}
+		double allReadSeconds = ElapsedSeconds(begin);
+		for (int i = 0; i < numSource; ++i)
+		{
+			sound.DeleteSource(("allread" + std::to_string(i)).c_str());
+		}
+
+		report->Add("load", "streaming_sync_ms_total", streamingSeconds * 1e3);
+		report->Add("load", "streaming_sync_ms_per_source", streamingSeconds * 1e3 / numSource);
+		report->Add("load", "allread_async_ms_total", allReadSeconds * 1e3);
+		report->Add("load", "allread_async_ms_per_source", allReadSeconds * 1e3 / numSource);
+		report->Add("load", "allread_async_failed", failed);
+	}
+	//Xg[~O\[XSă[vĐAaudioSeconds`悷
+	//`̂тɏς݃obt@[I܂ł̎([x)ƁAL[sĎ~܂(A_[)𐔂
+	static void SuiteStreaming(SoundClass& sound, int numSource, double audioSeconds, int renderFrames, BenchmarkReport* report)
+	{
+		std::vector<SoundSource*> sources;
+		std::vector<ALuint> sourceIDs;
+		for (int i = 0; i < numSource; ++i)
+		{
+			SoundSource* source = sound.GetSource(("stream" + std::to_string(i)).c_str());
+			source->Play(true);
+			sources.push_back(source);
+			sourceIDs.push_back(source->GetSourceID());
+		}
+		//Play̓XPW[[oRŎŝőS\[Xn߂܂ő҂
+		auto begin = std::chrono::steady_clock::now();
+		while (ElapsedSeconds(begin) < 1.0 && CountPlaying(sourceIDs) < numSource)
+		{
+			std::this_thread::sleep_for(std::chrono::microseconds(100));
+		}
+
+		std::vector<short> mix(renderFrames * 2);
+		std::vector<double> latencies;
+		std::vector<bool> isPlaying(numSource);
+		for (int i = 0; i < numSource; ++i)
+		{
+			ALint state;
+			alGetSourcei(sourceIDs[i], AL_SOURCE_STATE, &state);
+			isPlaying[i] = state == AL_PLAYING;
+		}
+		long long underruns = 0;
+		long long timeouts = 0;
+		long long renderedFrames = 0;
+		long long targetFrames = (long long)(audioSeconds * sound.GetLoopbackRate());
+
+		double processBegin = GetProcessCpuSeconds();
+		double threadBegin = GetThreadCpuSeconds();
+		begin = std::chrono::steady_clock::now();
+		while (renderedFrames < targetFrames)
+		{
+			sound.Render(mix.data(), renderFrames);
+			renderedFrames += renderFrames;
+			auto renderEnd = std::chrono::steady_clock::now();
+
+			//[ȌԂŃL[sĎ~܂\[X𐔂
+			for (int i = 0; i < numSource; ++i)
+			{
+				ALint state;
+				alGetSourcei(sourceIDs[i], AL_SOURCE_STATE, &state);
+				bool playing = state == AL_PLAYING;
+				if (isPlaying[i] && !playing)
+				{
+					++underruns;
+				}
+				isPlaying[i] = playing;
+			}
+			if (CountProcessed(sourceIDs) == 0)
+			{
+				continue;
+			}
+			//S\[X̏ς݃obt@Ȃ܂ł[xƂ (100msőł؂)
+			while (CountProcessed(sourceIDs) > 0)
+			{
+				if (ElapsedSeconds(renderEnd) > 0.1)
+				{
+					++timeouts;
+					break;
+				}
+				std::this_thread::sleep_for(std::chrono::microseconds(50));
+			}
+			latencies.push_back(ElapsedSeconds(renderEnd) * 1e6);
+		}
+		double wallSeconds = ElapsedSeconds(begin);
+		double processSeconds = GetProcessCpuSeconds() - processBegin;
+		double threadSeconds = GetThreadCpuSeconds() - threadBegin;
+		double renderedSeconds = (double)renderedFrames / sound.GetLoopbackRate();
+
+		for (auto source : sources)
+		{
+			source->Stop();
+		}
+
+		report->Add("streaming", "sources", numSource);
+		report->Add("streaming", "rendered_seconds", renderedSeconds);
+		report->Add("streaming", "wall_seconds", wallSeconds);
+		report->Add("streaming", "realtime_factor", renderedSeconds / wallSeconds);
+		report->Add("streaming", "underruns", (double)underruns);
+		report->Add("streaming", "refill_timeouts", (double)timeouts);
+		report->Add("streaming", "refill_count", (double)latencies.size());
+		report->Add("streaming", "refill_latency_us_mean", Mean(latencies));
+		report->Add("streaming", "refill_latency_us_p50", Percentile(latencies, 0.5));
+		report->Add("streaming", "refill_latency_us_p99", Percentile(latencies, 0.99));
+		report->Add("streaming", "refill_latency_us_max", Percentile(latencies, 1.0));
+		//`Xbh(̃Xbh)ȊOCPUԂAĐ1bE1\[X̊ɂ
+		if (processSeconds >= 0.0 && threadSeconds >= 0.0)
+		{
+			report->Add("streaming", "cpu_percent_per_source", (processSeconds - threadSeconds) / renderedSeconds / numSource * 100.0);
+			report->Add("streaming", "render_cpu_percent", threadSeconds / renderedSeconds * 100.0);
+		}
+	}
+	//PlayCopy32񂸂ς݁AS{CXɊ蓖Ă܂ł̎ԂPlayCopy̏x𑪂
+	//{CX̎gp邽߂SoundClassƂ͕ʂɃ{CXv[pӂ
+	static void SuitePlayCopy(const char* filePass, BenchmarkReport* report)
+	{
+		const int batch = 32;
+		SoundBufferCache cache;
+		SoundScheduler scheduler;
+		VoicePool voices(batch, &scheduler);
+		SoundEnvironment environment = {};
+		environment.cache = &cache;
+		environment.scheduler = &scheduler;
+		environment.voices = &voices;
+		SoundSource source(filePass, SoundSource::LoadMode::AllRead, 32, &environment);
+
+		std::vector<double> latencies;
+		long long played = 0;
+		double busySeconds = 0.0;
+		auto begin = std::chrono::steady_clock::now();
+		while (ElapsedSeconds(begin) < 1.0)
+		{
+			auto batchBegin = std::chrono::steady_clock::now();
+			for (int i = 0; i < batch; ++i)
+			{
+				source.PlayCopy();
+			}
+			while (voices.GetNumUsed() < batch && ElapsedSeconds(batchBegin) < 1.0)
+			{
+				std::this_thread::yield();
+			}
+			double batchSeconds = ElapsedSeconds(batchBegin);
+			busySeconds += batchSeconds;
+			latencies.push_back(batchSeconds * 1e6);
+			played += voices.GetNumUsed();
+
+			voices.StopOwner(&source);
+			while (voices.GetNumUsed() > 0)
+			{
+				std::this_thread::yield();
+			}
+		}
+
+		report->Add("playcopy", "batch", batch);
+		report->Add("playcopy", "played", (double)played);
+		report->Add("playcopy", "calls_per_second", played / busySeconds);
+		report->Add("playcopy", "batch_latency_us_mean", Mean(latencies));
+		report->Add("playcopy", "batch_latency_us_p99", Percentile(latencies, 0.99));
+	}
+	//SoundStats̃JE^[܂Ƃ߂sectionɒǉ
+	static void AddStats(const SoundStats::Snapshot& stats, const std::string& section, BenchmarkReport* report)
+	{
+		report->Add(section, "underruns", (double)stats.underruns);
+		report->Add(section, "restarts", (double)stats.restarts);
+		report->Add(section, "refills", (double)stats.refills);
+		report->Add(section, "bytes_read", (double)stats.bytesRead);
+		report->Add(section, "low_water_mark", stats.lowWaterMark);
+		for (int i = 0; i < SoundStats::NumLatencyBucket; ++i)
+		{
+			long long limit = SoundStats::GetLatencyBucketLimit(i);
+			std::string key = limit < 0 ? "refill_latency_inf" : "refill_latency_lt_" + std::to_string(limit) + "us";
+			report->Add(section, key, (double)stats.refillLatency[i]);
+		}
+		report->Add(section, "prefetch_hits", (double)stats.prefetchHits);
+		report->Add(section, "prefetch_misses", (double)stats.prefetchMisses);
+		report->Add(section, "prefetch_mean_occupancy", stats.prefetchHits > 0 ? (double)stats.prefetchOccupancy / stats.prefetchHits : 0.0);
+	}
+	static int CountPlaying(const std::vector<ALuint>& sourceIDs)
+	{
+		int count = 0;
+		for (ALuint sourceID : sourceIDs)
+		{
+			ALint state;
+			alGetSourcei(sourceID, AL_SOURCE_STATE, &state);
+			count += state == AL_PLAYING ? 1 : 0;
+		}
+		return count;
+	}
+	static int CountProcessed(const std::vector<ALuint>& sourceIDs)
+	{
+		int count = 0;
+		for (ALuint sourceID : sourceIDs)
+		{
+			ALint processed;
+			alGetSourcei(sourceID, AL_BUFFERS_PROCESSED, &processed);
+			count += processed;
+		}
+		return count;
+	}
+};
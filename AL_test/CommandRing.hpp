@@ -0,0 +1,80 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+//Xbhς߂āA̃XbhoŒ蒷̃bNt[L[
+//eZɐԍāAςޑ͈ʒuCASŊmۂ邾ő҂Ȃ
+template<class T, size_t Capacity>
+class CommandRing
+{
+	static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+private:
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T data;
+	};
+	Cell cells_[Capacity];
+	//ςޑƎoŕʂ̃LbVCɒu
+	alignas(64) std::atomic<size_t> enqueuePos_;
+	alignas(64) std::atomic<size_t> dequeuePos_;
+
+	//ꉞRs[֎~
+	CommandRing(const CommandRing&) = delete;
+	CommandRing& operator=(const CommandRing&) = delete;
+public:
+	CommandRing()
+	{
+		for (size_t i = 0; i < Capacity; ++i)
+		{
+			cells_[i].sequence.store(i, std::memory_order_relaxed);
+		}
+		enqueuePos_.store(0, std::memory_order_relaxed);
+		dequeuePos_.store(0, std::memory_order_relaxed);
+	}
+	//tȂfalseԂ (҂Ȃ)
+	bool Push(const T& data)
+	{
+		size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+		Cell* cell;
+		for (;;)
+		{
+			cell = &cells_[pos & (Capacity - 1)];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			std::ptrdiff_t diff = (std::ptrdiff_t)sequence - (std::ptrdiff_t)pos;
+			if (diff == 0)
+			{
+				if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				{
+					break;
+				}
+			}
+			else if (diff < 0)
+			{
+				return false;
+			}
+			else
+			{
+				pos = enqueuePos_.load(std::memory_order_relaxed);
+			}
+		}
+		cell->data = data;
+		cell->sequence.store(pos + 1, std::memory_order_release);
+		return true;
+	}
+	//oXbh͈ɂ邱ƁBȂfalseԂ
+	bool Pop(T* data)
+	{
+		size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+		Cell* cell = &cells_[pos & (Capacity - 1)];
+		size_t sequence = cell->sequence.load(std::memory_order_acquire);
+		if (sequence != pos + 1)
+		{
+			return false;
+		}
+		dequeuePos_.store(pos + 1, std::memory_order_relaxed);
+		*data = cell->data;
+		cell->sequence.store(pos + Capacity, std::memory_order_release);
+		return true;
+	}
+};
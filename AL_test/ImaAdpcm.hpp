@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+//IMA ADPCM (16bit4bitɈk) ̕ƕ
+//ubN̕тWAVIMA ADPCMAL_EXT_IMA4ƓŁA1ubN65t[
+//(`lƂ4oCg̃wb_[Ǎ̓`lƂ4oCg(8Tv)݂ɕ)
+//\l̍XVOpenAL Soft̕ƓɂāAƕŒlȂ悤ɂĂ
+class ImaAdpcm
+{
+public:
+	//AL_EXT_IMA4̊̃ubN (AL_SOFT_block_alignmentŕςɓn)
+	static const int SamplesPerBlock = 65;
+
+	static int GetBlockAlign(int channels)
+	{
+		return (4 + (SamplesPerBlock - 1) / 2) * channels;
+	}
+	//frames߂̂ɗvoCg (Ō̃ubN͖߂̂Ő؂グ)
+	static int GetEncodedBytes(int frames, int channels)
+	{
+		return (frames + SamplesPerBlock - 1) / SamplesPerBlock * GetBlockAlign(channels);
+	}
+	//16bitPCM𕄍outɏBŌ̃ubN̗]͍Ō̃TvŖ߂
+	static void Encode(const std::int16_t* pcm, int frames, int channels, std::vector<char>* out)
+	{
+		out->assign(GetEncodedBytes(frames, channels), 0);
+		std::uint8_t* dst = (std::uint8_t*)out->data();
+		int index[2] = { 0, 0 };
+		for (int begin = 0; begin < frames; begin += SamplesPerBlock)
+		{
+			int predictor[2];
+			for (int ch = 0; ch < channels; ++ch)
+			{
+				//ubN̐擪͂̂܂܃wb_[ɓ
+				predictor[ch] = pcm[(size_t)begin * channels + ch];
+				dst[0] = (std::uint8_t)(predictor[ch] & 0xff);
+				dst[1] = (std::uint8_t)((predictor[ch] >> 8) & 0xff);
+				dst[2] = (std::uint8_t)index[ch];
+				dst[3] = 0;
+				dst += 4;
+			}
+			//c64Tv8Tv(4oCg)`l݂ɋl߂
+			for (int group = 0; group < (SamplesPerBlock - 1) / 8; ++group)
+			{
+				for (int ch = 0; ch < channels; ++ch)
+				{
+					std::uint32_t code = 0;
+					for (int i = 0; i < 8; ++i)
+					{
+						int frame = begin + 1 + group * 8 + i;
+						if (frame >= frames)
+						{
+							frame = frames - 1;
+						}
+						std::uint32_t nibble = EncodeSample(pcm[(size_t)frame * channels + ch], &predictor[ch], &index[ch]);
+						code |= nibble << (4 * i);
+					}
+					dst[0] = (std::uint8_t)(code & 0xff);
+					dst[1] = (std::uint8_t)((code >> 8) & 0xff);
+					dst[2] = (std::uint8_t)((code >> 16) & 0xff);
+					dst[3] = (std::uint8_t)((code >> 24) & 0xff);
+					dst += 4;
+				}
+			}
+		}
+	}
+	//̂16bitPCMɖ߂ (ubNPʂȂ̂Œ65t[̔{ɂȂ)
+	static void Decode(const char* data, int bytes, int channels, std::vector<std::int16_t>* out)
+	{
+		int numBlock = bytes / GetBlockAlign(channels);
+		out->resize((size_t)numBlock * SamplesPerBlock * channels);
+		const std::uint8_t* src = (const std::uint8_t*)data;
+		std::int16_t* dst = out->data();
+		for (int block = 0; block < numBlock; ++block)
+		{
+			int predictor[2];
+			int index[2];
+			for (int ch = 0; ch < channels; ++ch)
+			{
+				predictor[ch] = (std::int16_t)(src[0] | (src[1] << 8));
+				index[ch] = src[2] > 88 ? 88 : src[2];
+				dst[ch] = (std::int16_t)predictor[ch];
+				src += 4;
+			}
+			for (int group = 0; group < (SamplesPerBlock - 1) / 8; ++group)
+			{
+				for (int ch = 0; ch < channels; ++ch)
+				{
+					std::uint32_t code = src[0] | (src[1] << 8) | (src[2] << 16) | ((std::uint32_t)src[3] << 24);
+					src += 4;
+					for (int i = 0; i < 8; ++i)
+					{
+						int nibble = (code >> (4 * i)) & 0xf;
+						Step(nibble, &predictor[ch], &index[ch]);
+						dst[(size_t)(1 + group * 8 + i) * channels + ch] = (std::int16_t)predictor[ch];
+					}
+				}
+			}
+			dst += (size_t)SamplesPerBlock * channels;
+		}
+	}
+private:
+	static const int* GetStepTable()
+	{
+		static const int steps[89] = {
+			7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31,
+			34, 37, 41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143,
+			157, 173, 190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+			724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066, 2272, 2499, 2749, 3024,
+			3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+			15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767
+		};
+		return steps;
+	}
+	//nibbleŗ\lƃXebv̈ʒui߂ (ƕŋ)
+	static void Step(int nibble, int* predictor, int* index)
+	{
+		static const int codewords[16] = { 1, 3, 5, 7, 9, 11, 13, 15, -1, -3, -5, -7, -9, -11, -13, -15 };
+		static const int adjusts[16] = { -1, -1, -1, -1, 2, 4, 6, 8, -1, -1, -1, -1, 2, 4, 6, 8 };
+		int value = *predictor + codewords[nibble] * GetStepTable()[*index] / 8;
+		*predictor = value < -32768 ? -32768 : (value > 32767 ? 32767 : value);
+		int next = *index + adjusts[nibble];
+		*index = next < 0 ? 0 : (next > 88 ? 88 : next);
+	}
+	//\lƂ̍̃Xebv4bitɗʎq
+	static std::uint32_t EncodeSample(int sample, int* predictor, int* index)
+	{
+		int step = GetStepTable()[*index];
+		int diff = sample - *predictor;
+		int nibble = 0;
+		if (diff < 0)
+		{
+			nibble = 8;
+			diff = -diff;
+		}
+		//őʂ(2 * 3bit + 1) * step / 8 Ȃ̂ŁAꂪɈԋ߂Ȃ̂I
+		int magnitude = diff * 4 / step;
+		nibble |= magnitude > 7 ? 7 : magnitude;
+		Step(nibble, predictor, index);
+		return (std::uint32_t)nibble;
+	}
+};
@@ -0,0 +1,147 @@
+#pragma once
+#include <cstddef>
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+//t@CŜǂݎpŃɃ}bv
+//}bvĂԂGetData()̃|C^̂܂܃t@C̒gɂȂ
+class MappedFile
+{
+private:
+#ifdef _WIN32
+	HANDLE file_;
+	HANDLE mapping_;
+#else
+	int fd_;
+#endif
+	const char* data_;
+	size_t size_;
+
+	//ꉞRs[֎~
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+public:
+	MappedFile()
+	{
+#ifdef _WIN32
+		file_ = INVALID_HANDLE_VALUE;
+		mapping_ = nullptr;
+#else
+		fd_ = -1;
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+	~MappedFile()
+	{
+		Close();
+	}
+	bool Open(const char* filePass)
+	{
+		Close();
+#ifdef _WIN32
+		file_ = CreateFileA(filePass, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_ == INVALID_HANDLE_VALUE)
+		{
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file_, &fileSize) || fileSize.QuadPart == 0)
+		{
+			Close();
+			return false;
+		}
+		mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping_ == nullptr)
+		{
+			Close();
+			return false;
+		}
+		data_ = static_cast<const char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+		if (data_ == nullptr)
+		{
+			Close();
+			return false;
+		}
+		size_ = static_cast<size_t>(fileSize.QuadPart);
+#else
+		fd_ = open(filePass, O_RDONLY);
+		if (fd_ < 0)
+		{
+			return false;
+		}
+		struct stat st;
+		if (fstat(fd_, &st) != 0 || st.st_size == 0)
+		{
+			Close();
+			return false;
+		}
+		void* addr = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd_, 0);
+		if (addr == MAP_FAILED)
+		{
+			Close();
+			return false;
+		}
+		//擪珇ɓǂłgȂ̂Őǂ݂߂ɂĂ炤
+		madvise(addr, static_cast<size_t>(st.st_size), MADV_SEQUENTIAL);
+		data_ = static_cast<const char*>(addr);
+		size_ = static_cast<size_t>(st.st_size);
+#endif
+		return true;
+	}
+	void Close()
+	{
+#ifdef _WIN32
+		if (data_ != nullptr)
+		{
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_ != nullptr)
+		{
+			CloseHandle(mapping_);
+			mapping_ = nullptr;
+		}
+		if (file_ != INVALID_HANDLE_VALUE)
+		{
+			CloseHandle(file_);
+			file_ = INVALID_HANDLE_VALUE;
+		}
+#else
+		if (data_ != nullptr)
+		{
+			munmap(const_cast<char*>(data_), size_);
+		}
+		if (fd_ >= 0)
+		{
+			close(fd_);
+			fd_ = -1;
+		}
+#endif
+		data_ = nullptr;
+		size_ = 0;
+	}
+	bool IsOpen() const
+	{
+		return data_ != nullptr;
+	}
+	const char* GetData() const
+	{
+		return data_;
+	}
+	size_t GetSize() const
+	{
+		return size_;
+	}
+};
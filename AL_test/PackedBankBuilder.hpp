@@ -0,0 +1,204 @@
+#pragma once
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <filesystem>
+#include "Audio.hpp"
+
+//WAV܂Ƃ߂PackedBankFormat̃t@Cc[
+//AL_test pack <tH_|ꗗ> <o.sbk> ̌`ŌĂяo
+//tH_nƂ̉.wavSAO̓tH_̑΃pXgq/ŋ؂̂ɂ
+//ꗗ(SoundBankEntry::ReadManifesť`)nƁA̖Oƃt@Cō ([h͌Ȃ)
+class PackedBankBuilder
+{
+public:
+	static int Run(int argc, char* argv[])
+	{
+		if (argc < 4)
+		{
+			std::cout << "usage: AL_test pack <directory|manifest> <out.sbk>" << std::endl;
+			return 1;
+		}
+		const char* sourcePass = argv[2];
+		const char* outPass = argv[3];
+
+		std::vector<SoundBankEntry> entries;
+		std::error_code error;
+		if (std::filesystem::is_directory(sourcePass, error))
+		{
+			CollectWaves(sourcePass, &entries);
+		}
+		else if (!SoundBankEntry::ReadManifest(sourcePass, &entries))
+		{
+			std::cout << "can't read " << sourcePass << std::endl;
+			return 1;
+		}
+
+		std::string message;
+		if (!Build(entries, outPass, &message))
+		{
+			std::cout << message << std::endl;
+			return 1;
+		}
+		std::cout << "packed " << entries.size() << " sounds into " << outPass << std::endl;
+		return 0;
+	}
+	//directorỷ.wavSentriesɑ
+	static void CollectWaves(const char* directory, std::vector<SoundBankEntry>* entries)
+	{
+		std::error_code error;
+		for (std::filesystem::recursive_directory_iterator it(directory, error), end; !error && it != end; it.increment(error))
+		{
+			const std::filesystem::path& path = it->path();
+			if (!it->is_regular_file(error) || path.extension() != ".wav")
+			{
+				continue;
+			}
+			std::filesystem::path relative = path.lexically_relative(directory);
+			relative.replace_extension();
+			SoundBankEntry entry;
+			entry.name = relative.generic_string();
+			entry.filePass = path.string();
+			entries->push_back(entry);
+		}
+	}
+	//entriesWAV܂Ƃ߂filePassɏo
+	//WavDataœǂ߂Ȃt@C▼Ȍd΁AoOfalseԂmessageɗR
+	static bool Build(const std::vector<SoundBankEntry>& entries, const char* filePass, std::string* message)
+	{
+		//͖Oɕׂ (PackedBank::Find񕪒T)
+		std::vector<const SoundBankEntry*> sorted;
+		for (const SoundBankEntry& entry : entries)
+		{
+			sorted.push_back(&entry);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](const SoundBankEntry* a, const SoundBankEntry* b) { return a->name < b->name; });
+
+		//Ƀwb_[S͂āAzu߂
+		std::vector<PackedBankFormat::Entry> index(sorted.size());
+		std::vector<std::uint64_t> sourceOffsets(sorted.size());
+		std::string names;
+		for (size_t i = 0; i < sorted.size(); ++i)
+		{
+			const SoundBankEntry& entry = *sorted[i];
+			if (entry.name.empty() || (i > 0 && entry.name == sorted[i - 1]->name))
+			{
+				*message = "bad or duplicated name : " + entry.name;
+				return false;
+			}
+			std::ifstream waveFile(entry.filePass, std::ifstream::binary);
+			AudioData data = AudioData();
+			if (!waveFile || !WavData::ParseHeader(waveFile, &data))
+			{
+				*message = "not wav : " + entry.filePass;
+				return false;
+			}
+			//data`Nt@C̓rŐ؂Ă̂́A镪 (MappedWavDataƓ)
+			waveFile.clear();
+			waveFile.seekg(0, std::ios_base::end);
+			std::int64_t available = std::max<std::int64_t>(0, (std::int64_t)waveFile.tellg() - data.dataStartOffset);
+			if ((std::int64_t)data.pcmSize * data.fileBlockSize > available)
+			{
+				data.pcmSize = (int)(available / data.fileBlockSize);
+				if (data.loopStart >= data.pcmSize)
+				{
+					data.loopStart = 0;
+				}
+				if (data.loopStart + data.loopLength > data.pcmSize)
+				{
+					data.loopLength = data.pcmSize - data.loopStart;
+				}
+			}
+
+			PackedBankFormat::Entry& packed = index[i];
+			packed = PackedBankFormat::Entry();
+			packed.nameHash = SoundId::Hash(entry.name.c_str());
+			packed.nameOffset = (std::uint32_t)names.size();
+			packed.nameLength = (std::uint32_t)entry.name.size();
+			packed.samplingRate = (std::uint32_t)data.samplingRate;
+			packed.numChannel = (std::uint16_t)SoundFormatInfo::GetChannels(data.format);
+			packed.fileBits = (std::uint16_t)data.fileBits;
+			packed.isFileFloat = data.isFileFloat ? 1 : 0;
+			packed.pcmSize = data.pcmSize;
+			packed.loopStart = data.loopStart;
+			packed.loopLength = data.loopLength;
+			packed.dataBytes = (std::uint64_t)data.pcmSize * data.fileBlockSize;
+			sourceOffsets[i] = (std::uint64_t)data.dataStartOffset;
+			names += entry.name;
+			names += '\0';
+		}
+		std::uint64_t offset = Align(sizeof(PackedBankFormat::Header) + index.size() * sizeof(PackedBankFormat::Entry) + names.size());
+		for (PackedBankFormat::Entry& packed : index)
+		{
+			packed.dataOffset = offset;
+			offset = Align(offset + packed.dataBytes);
+		}
+
+		std::ofstream file(filePass, std::ios::binary | std::ios::trunc);
+		if (!file)
+		{
+			*message = "can't write " + std::string(filePass);
+			return false;
+		}
+		PackedBankFormat::Header header;
+		memcpy(header.magic, "SBNK", 4);
+		header.version = PackedBankFormat::Version;
+		header.numEntry = (std::uint32_t)index.size();
+		header.nameBytes = (std::uint32_t)names.size();
+		file.write((const char*)&header, sizeof(header));
+		if (!index.empty())
+		{
+			file.write((const char*)index.data(), index.size() * sizeof(PackedBankFormat::Entry));
+		}
+		file.write(names.data(), names.size());
+
+		//PCM͌̃t@C班ʂ (SɎȂ)
+		std::vector<char> buffer(64 * 1024);
+		for (size_t i = 0; i < index.size(); ++i)
+		{
+			Pad(file, index[i].dataOffset);
+			std::ifstream waveFile(sorted[i]->filePass, std::ifstream::binary);
+			waveFile.seekg((std::streamoff)sourceOffsets[i], std::ios_base::beg);
+			std::uint64_t remaining = index[i].dataBytes;
+			while (remaining > 0 && waveFile)
+			{
+				std::streamsize size = (std::streamsize)std::min<std::uint64_t>(remaining, buffer.size());
+				waveFile.read(buffer.data(), size);
+				file.write(buffer.data(), waveFile.gcount());
+				remaining -= (std::uint64_t)waveFile.gcount();
+			}
+			if (remaining > 0)
+			{
+				*message = "can't read " + sorted[i]->filePass;
+				return false;
+			}
+		}
+		//ŌPCME܂Ŗ߂Ă (}bvɎ̃y[W܂Ȃ)
+		Pad(file, offset);
+		if (!file)
+		{
+			*message = "can't write " + std::string(filePass);
+			return false;
+		}
+		return true;
+	}
+private:
+	static std::uint64_t Align(std::uint64_t offset)
+	{
+		return (offset + PackedBankFormat::Alignment - 1) / PackedBankFormat::Alignment * PackedBankFormat::Alignment;
+	}
+	//offseẗʒu܂0Ŗ߂
+	static void Pad(std::ofstream& file, std::uint64_t offset)
+	{
+		static const char zero[256] = {};
+		std::uint64_t position = (std::uint64_t)file.tellp();
+		while (position < offset)
+		{
+			std::streamsize size = (std::streamsize)std::min<std::uint64_t>(offset - position, sizeof(zero));
+			file.write(zero, size);
+			position += size;
+		}
+	}
+};
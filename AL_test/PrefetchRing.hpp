@@ -0,0 +1,147 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+//t@C̓ǂݍ݂I/Op̃XbhŐɍς܂Ă߂̃Oobt@
+//I/O(1)ubNPʂŋl߁A[(XPW[[̃Xbh)o
+//ǂݍݒ̓bNȂ̂ŁAfBXNlbg[NxĂ[͑҂Ȃ
+class PrefetchRing
+{
+public:
+	struct Block
+	{
+		//I/Oǂݍޗ̈ (1ubNmۂĂ)
+		std::vector<char> storage;
+		//ǂ񂾃f[^BstorageA}bvς݃t@C̗̈𒼐ڎw
+		const char* data;
+		int size;
+		//̃ubNŃ[vI[([v΃t@CI[)ɒB
+		//I/O̓[vJnʒuɖ߂ēǂݑ̂ŁA[vȂ͕[Ŏ~߂邱
+		bool isLoopEnd;
+	};
+private:
+	mutable std::mutex mutex_;
+	std::condition_variable idleCv_;
+	std::vector<Block> blocks_;
+	//ɎoʒuƁAoubN
+	int head_;
+	int numReady_;
+	//I/Ȍς܂Ă邩s
+	bool isFilling_;
+	bool isClosed_;
+	//Resető₷BǂݍݒResetꂽ炻̌ʂ͎̂Ă
+	unsigned generation_;
+	//I/OɓǂޑOɃV[Nʒu (-1)
+	int seekRequest_;
+
+	//ꉞRs[֎~
+	PrefetchRing(const PrefetchRing&) = delete;
+	PrefetchRing& operator=(const PrefetchRing&) = delete;
+public:
+	PrefetchRing(int depth, int blockBytes)
+	{
+		if (depth < 1)
+		{
+			depth = 1;
+		}
+		blocks_.resize(depth);
+		for (auto& block : blocks_)
+		{
+			block.storage.resize(blockBytes);
+			block.data = nullptr;
+			block.size = 0;
+			block.isLoopEnd = false;
+		}
+		head_ = 0;
+		numReady_ = 0;
+		isFilling_ = false;
+		isClosed_ = false;
+		generation_ = 0;
+		seekRequest_ = -1;
+	}
+	~PrefetchRing()
+	{
+		Close();
+	}
+	//[: I/ȌςނׂȂtrueԂ (true󂯎KI/Ȍ1s邱)
+	bool RequestFill()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (isFilling_ || isClosed_ || numReady_ == (int)blocks_.size())
+		{
+			return false;
+		}
+		isFilling_ = true;
+		return true;
+	}
+	//I/O: ɋl߂ubN󂯎BseekTo0ȏȂ炻̈ʒuɃV[NĂǂ
+	//tĂfalseԂ̂ŁAI/ȌI邱
+	bool BeginWrite(Block** block, unsigned* generation, int* seekTo)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (isClosed_ || numReady_ == (int)blocks_.size())
+		{
+			isFilling_ = false;
+			idleCv_.notify_all();
+			return false;
+		}
+		*block = &blocks_[(head_ + numReady_) % blocks_.size()];
+		*generation = generation_;
+		*seekTo = seekRequest_;
+		seekRequest_ = -1;
+		return true;
+	}
+	//I/O: ǂݏIubNm肷BǂłԂResetĂ̂ĂfalseԂ
+	bool EndWrite(unsigned generation)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (generation != generation_)
+		{
+			return false;
+		}
+		++numReady_;
+		return true;
+	}
+	//[: 擪̃ubN (nullptr)BgIPop邱
+	//numReadyɂ͎oubNԂ
+	const Block* Front(int* numReady) const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		*numReady = numReady_;
+		return numReady_ > 0 ? &blocks_[head_] : nullptr;
+	}
+	void Pop()
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		if (numReady_ > 0)
+		{
+			head_ = (head_ + 1) % blocks_.size();
+			--numReady_;
+		}
+	}
+	//[: ǂ݂̂ĂāApcmOffsetǂݒ (RequestFillōĊJ邱)
+	void Reset(int pcmOffset)
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		++generation_;
+		numReady_ = 0;
+		seekRequest_ = pcmOffset;
+	}
+	//ȏǂ܂Ȃ悤ɂāAsI/ȌÎ҂
+	void Close()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		isClosed_ = true;
+		idleCv_.wait(lock, [this] { return !isFilling_; });
+	}
+	int GetNumReady() const
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		return numReady_;
+	}
+	int GetDepth() const
+	{
+		return (int)blocks_.size();
+	}
+};
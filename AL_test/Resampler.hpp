@@ -0,0 +1,363 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include "SampleConverter.hpp"
+
+//|tF[YFIRɂgϊ (16bit̃mXeI)
+//͂L{ɕԂMɎ鏈ALʂ̈ʑƂɕWƂ̓ςōs (L/M = o/)
+//tsinčW͍鎞ɈxvZAςSIMDŉ
+//Ԃ̂ŁAf[^͋؂ĉxProcessɓnĂpڂ͏oȂ (rŔ񂾂Reset)
+class Resampler
+{
+private:
+	//ʑ̐zg̑g͌W\傫Ȃ肷̂ňȂ
+	static const int MaxPhase = 2048;
+
+	int inRate_;
+	int outRate_;
+	int channels_;
+	//o/ = upFactor_/downFactor_ ()
+	int upFactor_;
+	int downFactor_;
+	//1ʑ̃^bv (SIMDŊ؂悤8̔{)
+	int taps_;
+	//ʑƂ̃^bvtɕׂ (A͂Ƃ̂܂ܓς)
+	std::vector<float> coefficients_;
+	//`lƂ̓ (擪taps_-1͑O̎c)
+	std::vector<float> history_[2];
+	//̏o͂g͂̈ʒu(history_̓Y)ƈʑ
+	int position_;
+	int phase_;
+	//ϊ̍Ɨ̈
+	std::vector<std::int16_t> planar_[2];
+	std::vector<float> output_[2];
+
+	//ꉞRs[֎~
+	Resampler(const Resampler&) = delete;
+	Resampler& operator=(const Resampler&) = delete;
+public:
+	//taps͕ϊ̑ш悪͂Ɠ1ʑ̃^bv (Ƃ͔ɉđ₷)
+	Resampler(int inRate, int outRate, int channels, int taps = 32)
+	{
+		inRate_ = inRate;
+		outRate_ = outRate;
+		channels_ = channels;
+		upFactor_ = 0;
+		downFactor_ = 0;
+		taps_ = 0;
+		position_ = 0;
+		phase_ = 0;
+		if (!IsSupported(inRate, outRate, channels))
+		{
+			return;
+		}
+		int divisor = Gcd(inRate, outRate);
+		upFactor_ = outRate / divisor;
+		downFactor_ = inRate / divisor;
+		//Ԉ̓JbgIt镪tB^[𒷂
+		double ratio = inRate > outRate ? (double)inRate / outRate : 1.0;
+		taps_ = ((int)std::ceil(taps * ratio) + 7) / 8 * 8;
+		MakeCoefficients();
+		Reset();
+	}
+	//ΉĂȂg̑g`lȂfalse (ϊɂ̂܂܎g)
+	bool IsValid() const
+	{
+		return taps_ > 0;
+	}
+	static bool IsSupported(int inRate, int outRate, int channels)
+	{
+		if (inRate <= 0 || outRate <= 0 || (channels != 1 && channels != 2))
+		{
+			return false;
+		}
+		return outRate / Gcd(inRate, outRate) <= MaxPhase;
+	}
+	//Xg[r؂ꂽ(V[N)ɌĂŁAO̓͂̉e
+	void Reset()
+	{
+		for (int ch = 0; ch < channels_; ++ch)
+		{
+			history_[ch].assign(taps_ - 1, 0.0f);
+		}
+		//o͂0ԖڂtB^[̒S炿傤GetDelay()ɗʒun߂
+		int start = GetCenter() - GetDelay() * downFactor_;
+		position_ = taps_ - 1 + start / upFactor_;
+		phase_ = start % upFactor_;
+	}
+	int GetTaps() const
+	{
+		return taps_;
+	}
+	int GetInputRate() const
+	{
+		return inRate_;
+	}
+	int GetOutputRate() const
+	{
+		return outRate_;
+	}
+	//inFramesnɏoĂő̃t[
+	int GetMaxOutputFrames(int inFrames) const
+	{
+		return (int)(((long long)inFrames * upFactor_ + downFactor_ - 1) / downFactor_) + 1;
+	}
+	//tB^[̒x (o͂̃t[)
+	int GetDelay() const
+	{
+		return GetCenter() / downFactor_;
+	}
+	//16bitinFramesϊoutɏAt[Ԃ
+	//outɂGetMaxOutputFrames(inFrames)t[̗̈悪v
+	int Process(const std::int16_t* in, int inFrames, std::int16_t* out)
+	{
+		if (!IsValid() || inFrames < 0)
+		{
+			return 0;
+		}
+		//͂EʁXfloatɂđO̎čɕt
+		for (int ch = 0; ch < channels_; ++ch)
+		{
+			planar_[ch].resize(inFrames);
+			size_t used = history_[ch].size();
+			history_[ch].resize(used + inFrames);
+			if (channels_ == 1)
+			{
+				SampleConverter::S16ToF32(in, history_[ch].data() + used, inFrames);
+			}
+		}
+		if (channels_ == 2)
+		{
+			SampleConverter::DeinterleaveS16(in, planar_[0].data(), planar_[1].data(), inFrames);
+			for (int ch = 0; ch < 2; ++ch)
+			{
+				size_t used = history_[ch].size() - inFrames;
+				SampleConverter::S16ToF32(planar_[ch].data(), history_[ch].data() + used, inFrames);
+			}
+		}
+
+		int available = (int)history_[0].size();
+		int maxOut = GetMaxOutputFrames(inFrames);
+		for (int ch = 0; ch < channels_; ++ch)
+		{
+			output_[ch].resize(maxOut);
+		}
+		DotFunc dot = GetDot();
+		int frames = 0;
+		while (position_ < available && frames < maxOut)
+		{
+			const float* coefficients = coefficients_.data() + (size_t)phase_ * taps_;
+			for (int ch = 0; ch < channels_; ++ch)
+			{
+				output_[ch][frames] = dot(coefficients, history_[ch].data() + position_ - (taps_ - 1), taps_);
+			}
+			++frames;
+			phase_ += downFactor_;
+			position_ += phase_ / upFactor_;
+			phase_ %= upFactor_;
+		}
+
+		//̏o͂ɗv镪cđOɋl߂
+		int keepFrom = position_ - (taps_ - 1);
+		if (keepFrom > available)
+		{
+			keepFrom = available;
+		}
+		for (int ch = 0; ch < channels_; ++ch)
+		{
+			history_[ch].erase(history_[ch].begin(), history_[ch].begin() + keepFrom);
+		}
+		position_ -= keepFrom;
+
+		if (channels_ == 1)
+		{
+			SampleConverter::F32ToS16(output_[0].data(), out, frames);
+		}
+		else
+		{
+			for (int ch = 0; ch < 2; ++ch)
+			{
+				planar_[ch].resize(frames);
+				SampleConverter::F32ToS16(output_[ch].data(), planar_[ch].data(), frames);
+			}
+			SampleConverter::InterleaveS16(planar_[0].data(), planar_[1].data(), out, frames);
+		}
+		return frames;
+	}
+	//ǂݍݎ̈ꊇϊBtB^[̒x菜Aϊ̎gɍ킹
+	//ΉĂȂgȂ炻̂܂܂̃Rs[Ԃ
+	static std::vector<std::int16_t> Convert(const std::int16_t* in, int frames, int channels, int inRate, int outRate)
+	{
+		Resampler resampler(inRate, outRate, channels);
+		if (!resampler.IsValid() || inRate == outRate)
+		{
+			return std::vector<std::int16_t>(in, in + (size_t)frames * channels);
+		}
+		int delay = resampler.GetDelay();
+		int outFrames = (int)(((long long)frames * outRate + inRate - 1) / inRate);
+		//̓tB^[ʂ蔲܂Ŗ𑫂ĉo
+		std::vector<std::int16_t> tail((size_t)resampler.taps_ * channels, 0);
+		std::vector<std::int16_t> result((size_t)(resampler.GetMaxOutputFrames(frames) + resampler.GetMaxOutputFrames(resampler.taps_)) * channels);
+		int produced = resampler.Process(in, frames, result.data());
+		produced += resampler.Process(tail.data(), resampler.taps_, result.data() + (size_t)produced * channels);
+		if (produced < delay + outFrames)
+		{
+			outFrames = produced - delay;
+		}
+		return std::vector<std::int16_t>(result.begin() + (size_t)delay * channels, result.begin() + (size_t)(delay + outFrames) * channels);
+	}
+	//t@Cǂ񂾂܂܂PCM(8bit͕A32bitfloat)outRate16bitɕϊoutɏ
+	//ϊłȂgȂfalseԂ̂ŁAPCM̂܂܎g
+	static bool ConvertPcm(const char* pcm, int bytes, int channels, int bits, int inRate, int outRate, std::vector<char>* out)
+	{
+		if (inRate == outRate || !IsSupported(inRate, outRate, channels))
+		{
+			return false;
+		}
+		std::vector<std::int16_t> widened;
+		const std::int16_t* src = (const std::int16_t*)pcm;
+		int frames = bytes / (channels * bits / 8);
+		if (bits == 8)
+		{
+			widened.resize((size_t)frames * channels);
+			SampleConverter::U8ToS16((const std::uint8_t*)pcm, widened.data(), widened.size());
+			src = widened.data();
+		}
+		else if (bits == 32)
+		{
+			widened.resize((size_t)frames * channels);
+			SampleConverter::F32ToS16((const float*)pcm, widened.data(), widened.size());
+			src = widened.data();
+		}
+		std::vector<std::int16_t> converted = Convert(src, frames, channels, inRate, outRate);
+		out->resize(converted.size() * sizeof(std::int16_t));
+		memcpy(out->data(), converted.data(), out->size());
+		return true;
+	}
+private:
+	//L{ɕԂgł̃tB^[̒S (x𐮐ɂ邽߁A̔ɒu)
+	int GetCenter() const
+	{
+		return taps_ * upFactor_ / 2;
+	}
+	static int Gcd(int a, int b)
+	{
+		while (b != 0)
+		{
+			int t = a % b;
+			a = b;
+			b = t;
+		}
+		return a;
+	}
+	//0̑1ό`xbZ֐ (JCU[p)
+	static double BesselI0(double x)
+	{
+		double sum = 1.0;
+		double term = 1.0;
+		for (int k = 1; k < 50; ++k)
+		{
+			term *= (x / (2.0 * k)) * (x / (2.0 * k));
+			sum += term;
+			if (term < sum * 1e-12)
+			{
+				break;
+			}
+		}
+		return sum;
+	}
+	//L{ɕԂgł̒ʉ߃tB^[AʑƂɕĕׂ
+	void MakeCoefficients()
+	{
+		const double pi = 3.14159265358979323846;
+		//JCU[̃ (j~Ŗ-90dB)
+		const double beta = 8.6;
+		//ʉ߈͒Ⴂ̃iCLXgg9܂
+		const double rolloff = 0.9;
+		int length = taps_ * upFactor_;
+		double cutoff = 0.5 * rolloff * (inRate_ < outRate_ ? inRate_ : outRate_) / ((double)inRate_ * upFactor_);
+		double center = GetCenter();
+		double window = BesselI0(beta);
+		coefficients_.assign(length, 0.0f);
+		for (int j = 0; j < length; ++j)
+		{
+			double x = j - center;
+			double sinc = x == 0.0 ? 2.0 * cutoff : std::sin(2.0 * pi * cutoff * x) / (pi * x);
+			double r = x / center;
+			if (r < -1.0)
+			{
+				r = -1.0;
+			}
+			double kaiser = BesselI0(beta * std::sqrt(1.0 - r * r)) / window;
+			//ԂŊԂɓꂽ0̕ʂ̂upFactor_{Ė߂
+			double value = sinc * kaiser * upFactor_;
+			//ʑp = j % L k = j / LԖڂ̃^bvAʑƂɋtŒu
+			int phase = j % upFactor_;
+			int tap = j / upFactor_;
+			coefficients_[(size_t)phase * taps_ + (taps_ - 1 - tap)] = (float)value;
+		}
+	}
+	//ς͏o1TvƂɌĂԂ̂ŁA߃Zbg̔Process̍ŏɈxs
+	typedef float (*DotFunc)(const float* a, const float* b, int count);
+	static DotFunc GetDot()
+	{
+#if SAMPLE_CONVERTER_X86
+		switch (SampleConverter::GetIsa())
+		{
+		case SampleConverter::Isa::AVX2: return DotAVX2;
+		case SampleConverter::Isa::SSE2: return DotSSE2;
+		default: break;
+		}
+#endif
+		return DotScalar;
+	}
+	static float DotScalar(const float* a, const float* b, int count)
+	{
+		float sum = 0.0f;
+		for (int i = 0; i < count; ++i)
+		{
+			sum += a[i] * b[i];
+		}
+		return sum;
+	}
+#if SAMPLE_CONVERTER_X86
+	//^bv8̔{ɂĂ̂Œ[͖
+	static float DotSSE2(const float* a, const float* b, int count)
+	{
+		__m128 sum0 = _mm_setzero_ps();
+		__m128 sum1 = _mm_setzero_ps();
+		for (int i = 0; i < count; i += 8)
+		{
+			sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+			sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+		}
+		__m128 sum = _mm_add_ps(sum0, sum1);
+		sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+		sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+		return _mm_cvtss_f32(sum);
+	}
+	SAMPLE_CONVERTER_AVX2 static float DotAVX2(const float* a, const float* b, int count)
+	{
+		//Z̑҂B2{ɕđ
+		__m256 sum0 = _mm256_setzero_ps();
+		__m256 sum1 = _mm256_setzero_ps();
+		int i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+			sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8)));
+		}
+		if (i < count)
+		{
+			sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+		}
+		__m256 sum = _mm256_add_ps(sum0, sum1);
+		__m128 half = _mm_add_ps(_mm256_castps256_ps128(sum), _mm256_extractf128_ps(sum, 1));
+		half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+		half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+		return _mm_cvtss_f32(half);
+	}
+#endif
+};
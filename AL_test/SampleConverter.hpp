@@ -0,0 +1,501 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <cstring>
+
+//x86ȂSSE2͏ɎgAAVX2͎sCPU𒲂ׂĎg
+#if defined(_M_X64) || defined(__x86_64__) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2) || defined(__SSE2__)
+#define SAMPLE_CONVERTER_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define SAMPLE_CONVERTER_AVX2
+#else
+#define SAMPLE_CONVERTER_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define SAMPLE_CONVERTER_X86 0
+#endif
+
+//PCM̃Tv`̕ϊƃ`l̕בւ܂Ƃ߂
+//8bit͕(128)A16bit24bit͕tAfloat-1.0`1.0ƂĈ
+//24bitWAV̕т̂܂3oCgl܂gGfBA
+//|C^̃ACg͖ȂB`l܂ތ͌Ăяoő邱
+class SampleConverter
+{
+public:
+	enum class Isa
+	{
+		Scalar,
+		SSE2,
+		AVX2,
+	};
+	//CPUΉĂ钆ňԑ߃Zbg
+	static Isa GetSupportedIsa()
+	{
+		static const Isa supported = DetectIsa();
+		return supported;
+	}
+	//ݎgĂ閽߃Zbg
+	static Isa GetIsa()
+	{
+		return (Isa)CurrentIsa().load(std::memory_order_relaxed);
+	}
+	//vpɖ߃Zbg𗎂Ƃ (ΉĂȂ̂w肵ΉĂ钆ňԑ̂ɂȂ)
+	static void SetIsa(Isa isa)
+	{
+		if ((int)isa > (int)GetSupportedIsa())
+		{
+			isa = GetSupportedIsa();
+		}
+		CurrentIsa().store((int)isa, std::memory_order_relaxed);
+	}
+	static const char* GetIsaName(Isa isa)
+	{
+		switch (isa)
+		{
+		case Isa::SSE2: return "sse2";
+		case Isa::AVX2: return "avx2";
+		default: return "scalar";
+		}
+	}
+
+	//8bit -> 16bit (count)
+	static void U8ToS16(const std::uint8_t* src, std::int16_t* dst, size_t count)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = U8ToS16AVX2(src, dst, count); break;
+		case Isa::SSE2: done = U8ToS16SSE2(src, dst, count); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < count; ++i)
+		{
+			dst[i] = (std::int16_t)((src[i] - 0x80) << 8);
+		}
+	}
+	//16bit -> 8bit (countA8bit͐؂̂)
+	static void S16ToU8(const std::int16_t* src, std::uint8_t* dst, size_t count)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = S16ToU8AVX2(src, dst, count); break;
+		case Isa::SSE2: done = S16ToU8SSE2(src, dst, count); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < count; ++i)
+		{
+			dst[i] = (std::uint8_t)((src[i] >> 8) + 0x80);
+		}
+	}
+	//16bit -> float (count)
+	static void S16ToF32(const std::int16_t* src, float* dst, size_t count)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = S16ToF32AVX2(src, dst, count); break;
+		case Isa::SSE2: done = S16ToF32SSE2(src, dst, count); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < count; ++i)
+		{
+			dst[i] = src[i] * (1.0f / 32768.0f);
+		}
+	}
+	//float -> 16bit (countA͈͊O͖OaAŋߐڋɊۂ߂)
+	static void F32ToS16(const float* src, std::int16_t* dst, size_t count)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = F32ToS16AVX2(src, dst, count); break;
+		case Isa::SSE2: done = F32ToS16SSE2(src, dst, count); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < count; ++i)
+		{
+			//WAṼ`N2oCgE܂łȂ̂ŁA}bv܂܂floatmemcpyœǂ
+			float value;
+			memcpy(&value, src + i, sizeof(float));
+			value *= 32768.0f;
+			value = value < -32768.0f ? -32768.0f : (value > 32767.0f ? 32767.0f : value);
+			dst[i] = (std::int16_t)std::lrint(value);
+		}
+	}
+	//24bit -> 16bit (countA8bit͐؂̂)
+	static void S24ToS16(const std::uint8_t* src, std::int16_t* dst, size_t count)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		if (GetIsa() == Isa::AVX2)
+		{
+			done = S24ToS16AVX2(src, dst, count);
+		}
+#endif
+		for (size_t i = done; i < count; ++i)
+		{
+			dst[i] = (std::int16_t)(src[3 * i + 1] | (src[3 * i + 2] << 8));
+		}
+	}
+	//24bit -> float (countAfloat̉Ɏ܂̂ŗ򉻂Ȃ)
+	static void S24ToF32(const std::uint8_t* src, float* dst, size_t count)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		if (GetIsa() == Isa::AVX2)
+		{
+			done = S24ToF32AVX2(src, dst, count);
+		}
+#endif
+		for (size_t i = done; i < count; ++i)
+		{
+			std::int32_t value = (std::int32_t)((std::uint32_t)src[3 * i] << 8 | (std::uint32_t)src[3 * i + 1] << 16 | (std::uint32_t)src[3 * i + 2] << 24) >> 8;
+			dst[i] = value * (1.0f / 8388608.0f);
+		}
+	}
+	//EʁX16bitXeIɕׂ (framesg)
+	static void InterleaveS16(const std::int16_t* ch0, const std::int16_t* ch1, std::int16_t* dst, size_t frames)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = InterleaveS16AVX2(ch0, ch1, dst, frames); break;
+		case Isa::SSE2: done = InterleaveS16SSE2(ch0, ch1, dst, frames); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < frames; ++i)
+		{
+			dst[2 * i] = ch0[i];
+			dst[2 * i + 1] = ch1[i];
+		}
+	}
+	//XeI16bitEɕ (framesg)
+	//Е~͂Еnullptrn
+	static void DeinterleaveS16(const std::int16_t* src, std::int16_t* ch0, std::int16_t* ch1, size_t frames)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = DeinterleaveS16AVX2(src, ch0, ch1, frames); break;
+		case Isa::SSE2: done = DeinterleaveS16SSE2(src, ch0, ch1, frames); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < frames; ++i)
+		{
+			if (ch0 != nullptr) ch0[i] = src[2 * i];
+			if (ch1 != nullptr) ch1[i] = src[2 * i + 1];
+		}
+	}
+	//XeI16bitE̕ςŃmɂ (framesg)
+	static void DownmixS16(const std::int16_t* src, std::int16_t* dst, size_t frames)
+	{
+		size_t done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (GetIsa())
+		{
+		case Isa::AVX2: done = DownmixS16AVX2(src, dst, frames); break;
+		case Isa::SSE2: done = DownmixS16SSE2(src, dst, frames); break;
+		default: break;
+		}
+#endif
+		for (size_t i = done; i < frames; ++i)
+		{
+			dst[i] = (std::int16_t)((src[2 * i] + src[2 * i + 1]) >> 1);
+		}
+	}
+private:
+	static std::atomic<int>& CurrentIsa()
+	{
+		static std::atomic<int> isa((int)GetSupportedIsa());
+		return isa;
+	}
+	static Isa DetectIsa()
+	{
+#if SAMPLE_CONVERTER_X86
+#ifdef _MSC_VER
+		int info[4];
+		__cpuid(info, 0);
+		if (info[0] >= 7)
+		{
+			__cpuid(info, 1);
+			//OSYMMWX^ۑĂ鎞AVX2g
+			bool hasOsAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+			__cpuidex(info, 7, 0);
+			if (hasOsAvx && (info[1] & (1 << 5)) != 0)
+			{
+				return Isa::AVX2;
+			}
+		}
+#else
+		__builtin_cpu_init();
+		if (__builtin_cpu_supports("avx2"))
+		{
+			return Isa::AVX2;
+		}
+#endif
+		return Isa::SSE2;
+#else
+		return Isa::Scalar;
+#endif
+	}
+
+#if SAMPLE_CONVERTER_X86
+	//ȉ͏łԂA[͌ĂяõXJ[ɔC
+	static size_t U8ToS16SSE2(const std::uint8_t* src, std::int16_t* dst, size_t count)
+	{
+		const __m128i bias = _mm_set1_epi8((char)0x80);
+		const __m128i zero = _mm_setzero_si128();
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			//𔽓]lʃoCgɒu(x-128)<<8ɂȂ
+			__m128i value = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(src + i)), bias);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_unpacklo_epi8(zero, value));
+			_mm_storeu_si128((__m128i*)(dst + i + 8), _mm_unpackhi_epi8(zero, value));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t U8ToS16AVX2(const std::uint8_t* src, std::int16_t* dst, size_t count)
+	{
+		const __m256i bias = _mm256_set1_epi16(0x80);
+		size_t i = 0;
+		for (; i + 32 <= count; i += 32)
+		{
+			__m256i lo = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + i)));
+			__m256i hi = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i*)(src + i + 16)));
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_slli_epi16(_mm256_sub_epi16(lo, bias), 8));
+			_mm256_storeu_si256((__m256i*)(dst + i + 16), _mm256_slli_epi16(_mm256_sub_epi16(hi, bias), 8));
+		}
+		return i;
+	}
+	static size_t S16ToU8SSE2(const std::int16_t* src, std::uint8_t* dst, size_t count)
+	{
+		const __m128i bias = _mm_set1_epi8((char)0x80);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m128i lo = _mm_srai_epi16(_mm_loadu_si128((const __m128i*)(src + i)), 8);
+			__m128i hi = _mm_srai_epi16(_mm_loadu_si128((const __m128i*)(src + i + 8)), 8);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_xor_si128(_mm_packs_epi16(lo, hi), bias));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t S16ToU8AVX2(const std::int16_t* src, std::uint8_t* dst, size_t count)
+	{
+		const __m256i bias = _mm256_set1_epi8((char)0x80);
+		size_t i = 0;
+		for (; i + 32 <= count; i += 32)
+		{
+			__m256i lo = _mm256_srai_epi16(_mm256_loadu_si256((const __m256i*)(src + i)), 8);
+			__m256i hi = _mm256_srai_epi16(_mm256_loadu_si256((const __m256i*)(src + i + 16)), 8);
+			//pack̓[Ƃɍŝ64bitPʂŕג
+			__m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi16(lo, hi), 0xD8);
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_xor_si256(packed, bias));
+		}
+		return i;
+	}
+	static size_t S16ToF32SSE2(const std::int16_t* src, float* dst, size_t count)
+	{
+		const __m128 scale = _mm_set1_ps(1.0f / 32768.0f);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			__m128i value = _mm_loadu_si128((const __m128i*)(src + i));
+			//16bitɒuĂZpVtgŕg
+			__m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(value, value), 16);
+			__m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(value, value), 16);
+			_mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+			_mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t S16ToF32AVX2(const std::int16_t* src, float* dst, size_t count)
+	{
+		const __m256 scale = _mm256_set1_ps(1.0f / 32768.0f);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src + i)));
+			__m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i*)(src + i + 8)));
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+			_mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+		}
+		return i;
+	}
+	static size_t F32ToS16SSE2(const float* src, std::int16_t* dst, size_t count)
+	{
+		const __m128 scale = _mm_set1_ps(32768.0f);
+		const __m128 minValue = _mm_set1_ps(-32768.0f);
+		const __m128 maxValue = _mm_set1_ps(32767.0f);
+		size_t i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			//int32ɕϊOɔ͈͓Ɏ߂ĂȂƑ傫Ȑ̒lɉ
+			__m128 lo = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i), scale), minValue), maxValue);
+			__m128 hi = _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_loadu_ps(src + i + 4), scale), minValue), maxValue);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(_mm_cvtps_epi32(lo), _mm_cvtps_epi32(hi)));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t F32ToS16AVX2(const float* src, std::int16_t* dst, size_t count)
+	{
+		const __m256 scale = _mm256_set1_ps(32768.0f);
+		const __m256 minValue = _mm256_set1_ps(-32768.0f);
+		const __m256 maxValue = _mm256_set1_ps(32767.0f);
+		size_t i = 0;
+		for (; i + 16 <= count; i += 16)
+		{
+			__m256 lo = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i), scale), minValue), maxValue);
+			__m256 hi = _mm256_min_ps(_mm256_max_ps(_mm256_mul_ps(_mm256_loadu_ps(src + i + 8), scale), minValue), maxValue);
+			__m256i packed = _mm256_packs_epi32(_mm256_cvtps_epi32(lo), _mm256_cvtps_epi32(hi));
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(packed, 0xD8));
+		}
+		return i;
+	}
+	//24bit̓oCgPʂ̕בւv̂AVX2 (SSE2̓XJ[ŏ)
+	//3oCg̃Tv32bit̏3oCgɒuAZpVtgŕg
+	//1[4Tv(12oCg)ǂނ̂ŁAŌ̓ǂݍ݂4oCg܂ŐG
+	SAMPLE_CONVERTER_AVX2 static __m256i LoadS24AVX2(const std::uint8_t* src)
+	{
+		const __m256i shuffle = _mm256_setr_epi8(
+			-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11,
+			-1, 0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11);
+		__m256i value = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)src)), _mm_loadu_si128((const __m128i*)(src + 12)), 1);
+		return _mm256_srai_epi32(_mm256_shuffle_epi8(value, shuffle), 8);
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t S24ToS16AVX2(const std::uint8_t* src, std::int16_t* dst, size_t count)
+	{
+		size_t i = 0;
+		//16TvōŌ̓ǂݍ݂(i+12)*316oCg
+		for (; i + 18 <= count; i += 16)
+		{
+			__m256i lo = _mm256_srai_epi32(LoadS24AVX2(src + 3 * i), 8);
+			__m256i hi = _mm256_srai_epi32(LoadS24AVX2(src + 3 * i + 24), 8);
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(lo, hi), 0xD8));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t S24ToF32AVX2(const std::uint8_t* src, float* dst, size_t count)
+	{
+		const __m256 scale = _mm256_set1_ps(1.0f / 8388608.0f);
+		size_t i = 0;
+		//8TvōŌ̓ǂݍ݂(i+4)*316oCg
+		for (; i + 10 <= count; i += 8)
+		{
+			_mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(LoadS24AVX2(src + 3 * i)), scale));
+		}
+		return i;
+	}
+	static size_t InterleaveS16SSE2(const std::int16_t* ch0, const std::int16_t* ch1, std::int16_t* dst, size_t frames)
+	{
+		size_t i = 0;
+		for (; i + 8 <= frames; i += 8)
+		{
+			__m128i left = _mm_loadu_si128((const __m128i*)(ch0 + i));
+			__m128i right = _mm_loadu_si128((const __m128i*)(ch1 + i));
+			_mm_storeu_si128((__m128i*)(dst + 2 * i), _mm_unpacklo_epi16(left, right));
+			_mm_storeu_si128((__m128i*)(dst + 2 * i + 8), _mm_unpackhi_epi16(left, right));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t InterleaveS16AVX2(const std::int16_t* ch0, const std::int16_t* ch1, std::int16_t* dst, size_t frames)
+	{
+		size_t i = 0;
+		for (; i + 16 <= frames; i += 16)
+		{
+			__m256i left = _mm256_loadu_si256((const __m256i*)(ch0 + i));
+			__m256i right = _mm256_loadu_si256((const __m256i*)(ch1 + i));
+			__m256i lo = _mm256_unpacklo_epi16(left, right);
+			__m256i hi = _mm256_unpackhi_epi16(left, right);
+			_mm256_storeu_si256((__m256i*)(dst + 2 * i), _mm256_permute2x128_si256(lo, hi, 0x20));
+			_mm256_storeu_si256((__m256i*)(dst + 2 * i + 16), _mm256_permute2x128_si256(lo, hi, 0x31));
+		}
+		return i;
+	}
+	static size_t DeinterleaveS16SSE2(const std::int16_t* src, std::int16_t* ch0, std::int16_t* ch1, size_t frames)
+	{
+		size_t i = 0;
+		for (; i + 8 <= frames; i += 8)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(src + 2 * i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(src + 2 * i + 8));
+			//32bit̉ʂAʂEȂ̂ŁAꂼꕄgĂlߒ
+			if (ch0 != nullptr)
+			{
+				__m128i left = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(_mm_slli_epi32(b, 16), 16));
+				_mm_storeu_si128((__m128i*)(ch0 + i), left);
+			}
+			if (ch1 != nullptr)
+			{
+				__m128i right = _mm_packs_epi32(_mm_srai_epi32(a, 16), _mm_srai_epi32(b, 16));
+				_mm_storeu_si128((__m128i*)(ch1 + i), right);
+			}
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t DeinterleaveS16AVX2(const std::int16_t* src, std::int16_t* ch0, std::int16_t* ch1, size_t frames)
+	{
+		size_t i = 0;
+		for (; i + 16 <= frames; i += 16)
+		{
+			__m256i a = _mm256_loadu_si256((const __m256i*)(src + 2 * i));
+			__m256i b = _mm256_loadu_si256((const __m256i*)(src + 2 * i + 16));
+			if (ch0 != nullptr)
+			{
+				__m256i left = _mm256_packs_epi32(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16), _mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16));
+				_mm256_storeu_si256((__m256i*)(ch0 + i), _mm256_permute4x64_epi64(left, 0xD8));
+			}
+			if (ch1 != nullptr)
+			{
+				__m256i right = _mm256_packs_epi32(_mm256_srai_epi32(a, 16), _mm256_srai_epi32(b, 16));
+				_mm256_storeu_si256((__m256i*)(ch1 + i), _mm256_permute4x64_epi64(right, 0xD8));
+			}
+		}
+		return i;
+	}
+	static size_t DownmixS16SSE2(const std::int16_t* src, std::int16_t* dst, size_t frames)
+	{
+		size_t i = 0;
+		for (; i + 8 <= frames; i += 8)
+		{
+			__m128i a = _mm_loadu_si128((const __m128i*)(src + 2 * i));
+			__m128i b = _mm_loadu_si128((const __m128i*)(src + 2 * i + 8));
+			//32bitőĂ犄̂ŌӂꂵȂ
+			__m128i sumA = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_slli_epi32(a, 16), 16), _mm_srai_epi32(a, 16)), 1);
+			__m128i sumB = _mm_srai_epi32(_mm_add_epi32(_mm_srai_epi32(_mm_slli_epi32(b, 16), 16), _mm_srai_epi32(b, 16)), 1);
+			_mm_storeu_si128((__m128i*)(dst + i), _mm_packs_epi32(sumA, sumB));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static size_t DownmixS16AVX2(const std::int16_t* src, std::int16_t* dst, size_t frames)
+	{
+		size_t i = 0;
+		for (; i + 16 <= frames; i += 16)
+		{
+			__m256i a = _mm256_loadu_si256((const __m256i*)(src + 2 * i));
+			__m256i b = _mm256_loadu_si256((const __m256i*)(src + 2 * i + 16));
+			__m256i sumA = _mm256_srai_epi32(_mm256_add_epi32(_mm256_srai_epi32(_mm256_slli_epi32(a, 16), 16), _mm256_srai_epi32(a, 16)), 1);
+			__m256i sumB = _mm256_srai_epi32(_mm256_add_epi32(_mm256_srai_epi32(_mm256_slli_epi32(b, 16), 16), _mm256_srai_epi32(b, 16)), 1);
+			_mm256_storeu_si256((__m256i*)(dst + i), _mm256_permute4x64_epi64(_mm256_packs_epi32(sumA, sumB), 0xD8));
+		}
+		return i;
+	}
+#endif
+};
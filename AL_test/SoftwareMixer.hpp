@@ -0,0 +1,354 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+#include "CommandRing.hpp"
+#include "SampleConverter.hpp"
+
+//̃VbgʉCPU1{̃XeI16bitɍ~LT[
+//OpenAL̃\[X̏Ɋ֌WȂ点̂ŁAo͂Xg[~O\[X1ŗĎg
+//{CX̏Ԃ͍ڂƂ̔z(SoA)ŎÃ[v͉ʂ|đɂSIMDŉ
+class SoftwareMixer
+{
+private:
+	//o^Bmright
+	struct Sound
+	{
+		std::vector<float> left;
+		std::vector<float> right;
+		int frames;
+	};
+	enum class CommandType
+	{
+		Play,
+		StopAll,
+	};
+	struct Command
+	{
+		CommandType type;
+		const Sound* sound;
+		float gainL, gainR;
+		bool loop;
+	};
+	//̃~bNXŏőt[ (蒷v͕ď)
+	static const int MixFrames = 1024;
+
+	int samplingRate_;
+	int maxVoice_;
+	//o^͌ĂяõXbhAQƂ̓~bNX̃XbhȂ̂ŁAo^͔j܂œȂ
+	std::mutex soundMutex_;
+	std::vector<Sound*> sounds_;
+	CommandRing<Command, 4096> commands_;
+
+	//ȉ̓~bNX̃XbhGB擪numVoice_Ă{CX
+	std::vector<const float*> sourceL_;
+	std::vector<const float*> sourceR_;
+	std::vector<int> position_;
+	std::vector<int> length_;
+	std::vector<float> gainL_;
+	std::vector<float> gainR_;
+	std::vector<char> isLoop_;
+	int numVoice_;
+	std::vector<float> mixL_;
+	std::vector<float> mixR_;
+	std::vector<std::int16_t> outL_;
+	std::vector<std::int16_t> outR_;
+
+	//ǂ̃Xbhłǂ߂
+	std::atomic<int> numActive_;
+	std::atomic<int> peakVoice_;
+	std::atomic<std::uint64_t> droppedVoices_;
+
+	//ꉞRs[֎~
+	SoftwareMixer(const SoftwareMixer&) = delete;
+	SoftwareMixer& operator=(const SoftwareMixer&) = delete;
+public:
+	//maxVoicezĖ炻Ƃ͎̂Ă (GetDroppedVoicesŐ)
+	SoftwareMixer(int samplingRate, int maxVoice = 4096)
+	{
+		samplingRate_ = samplingRate;
+		maxVoice_ = maxVoice < 1 ? 1 : maxVoice;
+		sourceL_.resize(maxVoice_);
+		sourceR_.resize(maxVoice_);
+		position_.resize(maxVoice_);
+		length_.resize(maxVoice_);
+		gainL_.resize(maxVoice_);
+		gainR_.resize(maxVoice_);
+		isLoop_.resize(maxVoice_);
+		numVoice_ = 0;
+		mixL_.resize(MixFrames);
+		mixR_.resize(MixFrames);
+		outL_.resize(MixFrames);
+		outR_.resize(MixFrames);
+		numActive_ = 0;
+		peakVoice_ = 0;
+		droppedVoices_ = 0;
+	}
+	~SoftwareMixer()
+	{
+		for (auto sound : sounds_)
+		{
+			delete sound;
+		}
+	}
+	//16bit(t)8bit()32bit(float)̃mXeIPCMo^APlayɓnԍԂ
+	//g~LT[ƈႤ̂ΉĂȂ`-1
+	int AddSound(const void* pcm, int frames, int channels, int bitsPerSample, int samplingRate)
+	{
+		if (samplingRate != samplingRate_ || frames <= 0 || (channels != 1 && channels != 2) || (bitsPerSample != 8 && bitsPerSample != 16 && bitsPerSample != 32))
+		{
+			return -1;
+		}
+		Sound* sound = new Sound();
+		sound->frames = frames;
+		size_t samples = (size_t)frames * channels;
+		//float͒Ŏ`ƓȂ̂ŁAEɕ邾
+		if (bitsPerSample == 32)
+		{
+			const float* src = (const float*)pcm;
+			sound->left.resize(frames);
+			if (channels == 2)
+			{
+				sound->right.resize(frames);
+			}
+			for (int i = 0; i < frames; ++i)
+			{
+				sound->left[i] = src[(size_t)i * channels];
+				if (channels == 2)
+				{
+					sound->right[i] = src[(size_t)i * 2 + 1];
+				}
+			}
+			std::lock_guard<std::mutex> lock(soundMutex_);
+			sounds_.push_back(sound);
+			return (int)sounds_.size() - 1;
+		}
+		std::vector<std::int16_t> s16;
+		const std::int16_t* src = (const std::int16_t*)pcm;
+		if (bitsPerSample == 8)
+		{
+			s16.resize(samples);
+			SampleConverter::U8ToS16((const std::uint8_t*)pcm, s16.data(), samples);
+			src = s16.data();
+		}
+		sound->left.resize(frames);
+		if (channels == 1)
+		{
+			SampleConverter::S16ToF32(src, sound->left.data(), frames);
+		}
+		else
+		{
+			std::vector<std::int16_t> left(frames), right(frames);
+			SampleConverter::DeinterleaveS16(src, left.data(), right.data(), frames);
+			sound->right.resize(frames);
+			SampleConverter::S16ToF32(left.data(), sound->left.data(), frames);
+			SampleConverter::S16ToF32(right.data(), sound->right.data(), frames);
+		}
+		std::lock_guard<std::mutex> lock(soundMutex_);
+		sounds_.push_back(sound);
+		return (int)sounds_.size() - 1;
+	}
+	//ǂ̃XbhĂł悭A҂ȂB̃~bNXn߂
+	//pan-1.0()`1.0(E)Bm͓p[ŐU蕪AXeI͔Αi
+	bool Play(int soundIndex, float gain = 1.0f, float pan = 0.0f, bool loop = false)
+	{
+		const Sound* sound = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(soundMutex_);
+			if (soundIndex < 0 || soundIndex >= (int)sounds_.size())
+			{
+				return false;
+			}
+			sound = sounds_[soundIndex];
+		}
+		pan = pan < -1.0f ? -1.0f : (pan > 1.0f ? 1.0f : pan);
+		Command command = { CommandType::Play, sound, gain, gain, loop };
+		if (sound->right.empty())
+		{
+			float angle = (pan + 1.0f) * 0.78539816f;
+			command.gainL = gain * std::cos(angle);
+			command.gainR = gain * std::sin(angle);
+		}
+		else
+		{
+			command.gainL = gain * (pan > 0.0f ? 1.0f - pan : 1.0f);
+			command.gainR = gain * (pan < 0.0f ? 1.0f + pan : 1.0f);
+		}
+		//tɂȂ̂̓~bNX~܂Ă鎞Ȃ̂ŁȀꍇ͎̂Ă
+		if (!commands_.Push(command))
+		{
+			droppedVoices_.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+		return true;
+	}
+	//ĂS{CX̃~bNXŎ~߂ ([vĐŎ~߂)
+	void StopAll()
+	{
+		commands_.Push({ CommandType::StopAll, nullptr, 0.0f, 0.0f, false });
+	}
+	//XeI16bitframesށB̃Xbh珇ɌĂԂ
+	void Mix(std::int16_t* out, int frames)
+	{
+		ExecuteCommands();
+		while (frames > 0)
+		{
+			int count = frames < MixFrames ? frames : MixFrames;
+			MixBlock(count);
+			//Nbv͕ϊ̖̎Oaōs
+			SampleConverter::F32ToS16(mixL_.data(), outL_.data(), count);
+			SampleConverter::F32ToS16(mixR_.data(), outR_.data(), count);
+			SampleConverter::InterleaveS16(outL_.data(), outR_.data(), out, count);
+			out += count * 2;
+			frames -= count;
+		}
+		numActive_.store(numVoice_, std::memory_order_relaxed);
+	}
+	int GetSamplingRate() const
+	{
+		return samplingRate_;
+	}
+	int GetMaxVoice() const
+	{
+		return maxVoice_;
+	}
+	//Õ~bNX̌ɖĂ{CX
+	int GetNumActive() const
+	{
+		return numActive_.load(std::memory_order_relaxed);
+	}
+	//ɖĂ{CX̍ő
+	int GetPeakVoice() const
+	{
+		return peakVoice_.load(std::memory_order_relaxed);
+	}
+	//L[̖tŖ点Ȃ
+	std::uint64_t GetDroppedVoices() const
+	{
+		return droppedVoices_.load(std::memory_order_relaxed);
+	}
+private:
+	void ExecuteCommands()
+	{
+		Command command;
+		while (commands_.Pop(&command))
+		{
+			if (command.type == CommandType::StopAll)
+			{
+				numVoice_ = 0;
+				continue;
+			}
+			if (numVoice_ == maxVoice_)
+			{
+				droppedVoices_.fetch_add(1, std::memory_order_relaxed);
+				continue;
+			}
+			int index = numVoice_++;
+			const Sound* sound = command.sound;
+			sourceL_[index] = sound->left.data();
+			sourceR_[index] = sound->right.empty() ? sound->left.data() : sound->right.data();
+			position_[index] = 0;
+			length_[index] = sound->frames;
+			gainL_[index] = command.gainL;
+			gainR_[index] = command.gainR;
+			isLoop_[index] = command.loop;
+		}
+		if (numVoice_ > peakVoice_.load(std::memory_order_relaxed))
+		{
+			peakVoice_.store(numVoice_, std::memory_order_relaxed);
+		}
+	}
+	//S{CXmixL_/mixR_̐擪countɑ݁AI{CX͖ƓւĊO
+	void MixBlock(int count)
+	{
+		std::fill(mixL_.begin(), mixL_.begin() + count, 0.0f);
+		std::fill(mixR_.begin(), mixR_.begin() + count, 0.0f);
+		for (int voice = 0; voice < numVoice_;)
+		{
+			int done = 0;
+			while (done < count)
+			{
+				int frames = length_[voice] - position_[voice];
+				if (frames > count - done)
+				{
+					frames = count - done;
+				}
+				MixVoice(sourceL_[voice] + position_[voice], sourceR_[voice] + position_[voice], gainL_[voice], gainR_[voice],
+					mixL_.data() + done, mixR_.data() + done, frames);
+				position_[voice] += frames;
+				done += frames;
+				if (position_[voice] < length_[voice] || !isLoop_[voice])
+				{
+					break;
+				}
+				position_[voice] = 0;
+			}
+			if (position_[voice] < length_[voice])
+			{
+				++voice;
+				continue;
+			}
+			RemoveVoice(voice);
+		}
+	}
+	void RemoveVoice(int index)
+	{
+		int last = --numVoice_;
+		sourceL_[index] = sourceL_[last];
+		sourceR_[index] = sourceR_[last];
+		position_[index] = position_[last];
+		length_[index] = length_[last];
+		gainL_[index] = gainL_[last];
+		gainR_[index] = gainR_[last];
+		isLoop_[index] = isLoop_[last];
+	}
+	//dstL += srcL * gainL, dstR += srcR * gainR (msrcLsrcR)
+	static void MixVoice(const float* srcL, const float* srcR, float gainL, float gainR, float* dstL, float* dstR, int count)
+	{
+		int done = 0;
+#if SAMPLE_CONVERTER_X86
+		switch (SampleConverter::GetIsa())
+		{
+		case SampleConverter::Isa::AVX2: done = MixVoiceAVX2(srcL, srcR, gainL, gainR, dstL, dstR, count); break;
+		case SampleConverter::Isa::SSE2: done = MixVoiceSSE2(srcL, srcR, gainL, gainR, dstL, dstR, count); break;
+		default: break;
+		}
+#endif
+		for (int i = done; i < count; ++i)
+		{
+			dstL[i] += srcL[i] * gainL;
+			dstR[i] += srcR[i] * gainR;
+		}
+	}
+#if SAMPLE_CONVERTER_X86
+	//ȉ͏łԂA[͌ĂяõXJ[ɔC
+	//FMAɂƊۂ߂XJ[ƕς̂ŁA|Ă瑫
+	static int MixVoiceSSE2(const float* srcL, const float* srcR, float gainL, float gainR, float* dstL, float* dstR, int count)
+	{
+		const __m128 gl = _mm_set1_ps(gainL);
+		const __m128 gr = _mm_set1_ps(gainR);
+		int i = 0;
+		for (; i + 4 <= count; i += 4)
+		{
+			_mm_storeu_ps(dstL + i, _mm_add_ps(_mm_loadu_ps(dstL + i), _mm_mul_ps(_mm_loadu_ps(srcL + i), gl)));
+			_mm_storeu_ps(dstR + i, _mm_add_ps(_mm_loadu_ps(dstR + i), _mm_mul_ps(_mm_loadu_ps(srcR + i), gr)));
+		}
+		return i;
+	}
+	SAMPLE_CONVERTER_AVX2 static int MixVoiceAVX2(const float* srcL, const float* srcR, float gainL, float gainR, float* dstL, float* dstR, int count)
+	{
+		const __m256 gl = _mm256_set1_ps(gainL);
+		const __m256 gr = _mm256_set1_ps(gainR);
+		int i = 0;
+		for (; i + 8 <= count; i += 8)
+		{
+			_mm256_storeu_ps(dstL + i, _mm256_add_ps(_mm256_loadu_ps(dstL + i), _mm256_mul_ps(_mm256_loadu_ps(srcL + i), gl)));
+			_mm256_storeu_ps(dstR + i, _mm256_add_ps(_mm256_loadu_ps(dstR + i), _mm256_mul_ps(_mm256_loadu_ps(srcR + i), gr)));
+		}
+		return i;
+	}
+#endif
+};
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//SoundClassɓo^\[Xwnh
+//g̓Xbg̔ԍƐŁÂ͔z̓Yōς
+//\[XƐオiނ̂ŁAɎcĂnhŕʂ̃\[XɐG邱Ƃ͂Ȃ
+struct SoundHandle
+{
+	std::uint32_t index;
+	//0͖ȃnh
+	std::uint32_t generation;
+
+	SoundHandle()
+	{
+		index = 0;
+		generation = 0;
+	}
+	SoundHandle(std::uint32_t index, std::uint32_t generation)
+	{
+		this->index = index;
+		this->generation = generation;
+	}
+	bool IsValid() const
+	{
+		return generation != 0;
+	}
+	bool operator==(const SoundHandle& other) const
+	{
+		return index == other.index && generation == other.generation;
+	}
+	bool operator!=(const SoundHandle& other) const
+	{
+		return !(*this == other);
+	}
+};
+
+//\[X̃RpCnbV (32bitFNV-1a)
+//constexpr std::uint32_t BgmId = SoundId::Hash("bgm"); ̂悤ɒ萔ɂĂ΁Asɕ炸Ɉ
+//ႤOlɂȂSoundClassォo^ۂ
+struct SoundId
+{
+	static constexpr std::uint32_t Hash(const char* name, std::uint32_t hash = 2166136261u)
+	{
+		return *name == '\0' ? hash : Hash(name + 1, (hash ^ (std::uint8_t)*name) * 16777619u);
+	}
+};
+
+//t̃XbgzB͋󂫂ƂĎg񂵁A̎ɐi߂
+//ɐGꍇ̔r͌Ăяoōs
+template<class T>
+class SlotMap
+{
+private:
+	struct Slot
+	{
+		T value;
+		//Ă(󂫂Ȃ玟ɓ)̐ (0͎gȂ)
+		std::uint32_t generation;
+		bool isUsed;
+	};
+	std::vector<Slot> slots_;
+	std::vector<std::uint32_t> freeList_;
+	size_t count_;
+public:
+	SlotMap()
+	{
+		count_ = 0;
+	}
+	SoundHandle Insert(const T& value)
+	{
+		std::uint32_t index;
+		if (!freeList_.empty())
+		{
+			index = freeList_.back();
+			freeList_.pop_back();
+		}
+		else
+		{
+			index = (std::uint32_t)slots_.size();
+			slots_.push_back(Slot());
+			slots_.back().generation = 1;
+		}
+		Slot& slot = slots_[index];
+		slot.value = value;
+		slot.isUsed = true;
+		++count_;
+		return SoundHandle(index, slot.generation);
+	}
+	//ꂽ̃nhȂnullptr
+	T* Get(SoundHandle handle)
+	{
+		if (handle.index >= slots_.size())
+		{
+			return nullptr;
+		}
+		Slot& slot = slots_[handle.index];
+		if (!slot.isUsed || slot.generation != handle.generation)
+		{
+			return nullptr;
+		}
+		return &slot.value;
+	}
+	bool Remove(SoundHandle handle)
+	{
+		if (Get(handle) == nullptr)
+		{
+			return false;
+		}
+		Slot& slot = slots_[handle.index];
+		slot.value = T();
+		slot.isUsed = false;
+		//0ɂȂ1ɖ߂
+		if (++slot.generation == 0)
+		{
+			slot.generation = 1;
+		}
+		freeList_.push_back(handle.index);
+		--count_;
+		return true;
+	}
+	//gĂXbgfunc(handle, value)ŏɉ
+	template<class Func>
+	void ForEach(Func func)
+	{
+		for (std::uint32_t i = 0; i < (std::uint32_t)slots_.size(); ++i)
+		{
+			if (slots_[i].isUsed)
+			{
+				func(SoundHandle(i, slots_[i].generation), slots_[i].value);
+			}
+		}
+	}
+	void Clear()
+	{
+		slots_.clear();
+		freeList_.clear();
+		count_ = 0;
+	}
+	size_t GetCount() const
+	{
+		return count_;
+	}
+};
@@ -0,0 +1,230 @@
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//S\[X̃obt@[Rs[Đ̌Еt̃Xbhł܂Ƃ߂čsXPW[[
+//e^XNԂuɏKvɂȂ鎞v̑ɗDxtL[oď
+class SoundScheduler
+{
+public:
+	using Clock = std::chrono::steady_clock;
+
+	//XPW[[ɓo^鏈̒P
+	class ITask
+	{
+	public:
+		ITask() = default;
+		virtual ~ITask() = default;
+		//sAɌĂłقԂ (Wake܂ŕsvȂClock::time_point::max())
+		virtual Clock::time_point Update(Clock::time_point now) = 0;
+	};
+private:
+	struct Item
+	{
+		Clock::time_point deadline;
+		ITask* task;
+		unsigned long long generation;
+	};
+	//̑̂擪ɂ
+	struct Later
+	{
+		bool operator()(const Item& a, const Item& b) const
+		{
+			return a.deadline > b.deadline;
+		}
+	};
+	struct TaskState
+	{
+		//L[ɐς񂾍ŐV̐ (Â̗vf͎oɎ̂Ă)
+		//͑S^XNŒʂ̔ԍɂ̂ŁAꂽ^XNƓAhXɍꂽ^XNÂvfƈv邱Ƃ͂Ȃ
+		unsigned long long generation;
+		bool isRunning;
+		bool isWake;
+	};
+
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	std::priority_queue<Item, std::vector<Item>, Later> queue_;
+	std::unordered_map<ITask*, TaskState> tasks_;
+	std::vector<std::thread> threads_;
+	//Ōɔz
+	unsigned long long lastGeneration_;
+	bool isEnd_;
+
+	//ꉞRs[֎~
+	SoundScheduler(const SoundScheduler&) = delete;
+	SoundScheduler& operator=(const SoundScheduler&) = delete;
+public:
+	SoundScheduler(int numThread = 1)
+	{
+		lastGeneration_ = 0;
+		isEnd_ = false;
+		if (numThread < 1)
+		{
+			numThread = 1;
+		}
+		for (int i = 0; i < numThread; ++i)
+		{
+			threads_.emplace_back(&SoundScheduler::WorkerThread, this);
+		}
+	}
+	~SoundScheduler()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isEnd_ = true;
+		}
+		cv_.notify_all();
+		for (auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+	//^XNo^ĂɈx
+	void Add(ITask* task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			TaskState& state = tasks_[task];
+			state.generation = ++lastGeneration_;
+			state.isRunning = false;
+			state.isWake = false;
+			queue_.push({ Clock::now(), task, state.generation });
+		}
+		cv_.notify_one();
+	}
+	//^XNo^BȂ炻̏I܂ő҂
+	void Remove(ITask* task)
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		auto it = tasks_.find(task);
+		if (it == tasks_.end())
+		{
+			return;
+		}
+		cv_.wait(lock, [&] { return !tasks_[task].isRunning; });
+		tasks_.erase(task);
+	}
+	//҂Ɏ̋󂫃Xbhŏ
+	void Wake(ITask* task)
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			auto it = tasks_.find(task);
+			if (it == tasks_.end())
+			{
+				return;
+			}
+			//ȂIɂx
+			if (it->second.isRunning)
+			{
+				it->second.isWake = true;
+				return;
+			}
+			it->second.generation = ++lastGeneration_;
+			queue_.push({ Clock::now(), task, it->second.generation });
+		}
+		cv_.notify_one();
+	}
+	//o^ĂS^XNĂяõXbhōx
+	//Ԃ葬`悷鎞ɁA҂ɕ[邽߂Ɏg
+	//Xbh̑ŏ̃^XN͂ꂪIĂ珈
+	void RunAll()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		std::vector<ITask*> tasks;
+		tasks.reserve(tasks_.size());
+		for (auto& it : tasks_)
+		{
+			tasks.push_back(it.first);
+		}
+		for (ITask* task : tasks)
+		{
+			//҂ĂԂɓo^Ă΂ (ꂽ̃^XNɂ͐GȂ)
+			cv_.wait(lock, [&] {
+				auto it = tasks_.find(task);
+				return it == tasks_.end() || !it->second.isRunning;
+			});
+			auto it = tasks_.find(task);
+			if (it == tasks_.end())
+			{
+				continue;
+			}
+			it->second.isRunning = true;
+
+			lock.unlock();
+			Clock::time_point next = task->Update(Clock::now());
+			lock.lock();
+
+			TaskState& state = tasks_[task];
+			state.isRunning = false;
+			if (state.isWake)
+			{
+				state.isWake = false;
+				next = Clock::now();
+			}
+			state.generation = ++lastGeneration_;
+			queue_.push({ next, task, state.generation });
+			cv_.notify_all();
+		}
+	}
+	int GetNumThread() const
+	{
+		return (int)threads_.size();
+	}
+private:
+	void WorkerThread()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (!isEnd_)
+		{
+			if (queue_.empty())
+			{
+				cv_.wait(lock);
+				continue;
+			}
+			Item item = queue_.top();
+			auto it = tasks_.find(item.task);
+			//o^ꂽAォςݒꂽÂvf͎̂Ă
+			if (it == tasks_.end() || it->second.generation != item.generation || it->second.isRunning)
+			{
+				queue_.pop();
+				continue;
+			}
+			if (item.deadline == Clock::time_point::max())
+			{
+				queue_.pop();
+				continue;
+			}
+			Clock::time_point now = Clock::now();
+			if (now < item.deadline)
+			{
+				cv_.wait_until(lock, item.deadline);
+				continue;
+			}
+			queue_.pop();
+			it->second.isRunning = true;
+
+			lock.unlock();
+			Clock::time_point next = item.task->Update(now);
+			lock.lock();
+
+			//ɓo^҂ĂXbh΂ɒm点
+			TaskState& state = tasks_[item.task];
+			state.isRunning = false;
+			if (state.isWake)
+			{
+				state.isWake = false;
+				next = Clock::now();
+			}
+			state.generation = ++lastGeneration_;
+			queue_.push({ next, item.task, state.generation });
+			cv_.notify_all();
+		}
+	}
+};
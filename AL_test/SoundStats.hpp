@@ -0,0 +1,168 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+//Xg[~ǑS(A_[L[̎c)𐔂JE^[
+//Ẑ̓\[XĂXbhŁAǂނ̂͂ǂ̃XbhłbNł悢
+//eݒ肷ƉZeɂf (SoundClassŜ̏WvɎg)
+class SoundStats
+{
+public:
+	//[x̃qXgŐ؂萔
+	static const int NumLatencyBucket = 10;
+	//鎞_̒l (ڂƂɕʁXɓǂނ̂ŁAڊԂŌɑĂƂ͌Ȃ)
+	struct Snapshot
+	{
+		//L[să\[X~܂
+		std::uint64_t underruns;
+		//~܂\[XĐ
+		std::uint64_t restarts;
+		//[obt@̐
+		std::uint64_t refills;
+		//t@Cǂ񂾃oCg
+		std::uint64_t bytesRead;
+		//[̒OɍĐ҂ŎcĂobt@̍ŏl (܂[ĂȂ-1)
+		int lowWaterMark;
+		//obt@ς݂ɂȂĂ[܂ł̎Ԃ̕z (؂GetLatencyBucketLimit)
+		std::uint64_t refillLatency[NumLatencyBucket];
+		//ǂ݃OoubN
+		std::uint64_t prefetchHits;
+		//o_ŃOɗ܂ĂubN̍v (prefetchHitsŊƕς̐L)
+		std::uint64_t prefetchOccupancy;
+		//[悤Ƃɐǂ݂ԂɍĂȂ
+		std::uint64_t prefetchMisses;
+	};
+	//qXgOindexԖڂ̋؂̏ (}CNbAŌ͏-1)
+	static long long GetLatencyBucketLimit(int index)
+	{
+		static const long long limits[NumLatencyBucket] = { 500, 1000, 2000, 4000, 8000, 16000, 32000, 64000, 128000, -1 };
+		return limits[index];
+	}
+private:
+	SoundStats* parent_;
+	std::atomic<std::uint64_t> underruns_;
+	std::atomic<std::uint64_t> restarts_;
+	std::atomic<std::uint64_t> refills_;
+	std::atomic<std::uint64_t> bytesRead_;
+	std::atomic<int> lowWaterMark_;
+	std::atomic<std::uint64_t> refillLatency_[NumLatencyBucket];
+	std::atomic<std::uint64_t> prefetchHits_;
+	std::atomic<std::uint64_t> prefetchOccupancy_;
+	std::atomic<std::uint64_t> prefetchMisses_;
+
+	//ꉞRs[֎~
+	SoundStats(const SoundStats&) = delete;
+	SoundStats& operator=(const SoundStats&) = delete;
+public:
+	SoundStats(SoundStats* parent = nullptr)
+	{
+		parent_ = parent;
+		underruns_ = 0;
+		restarts_ = 0;
+		refills_ = 0;
+		bytesRead_ = 0;
+		lowWaterMark_ = -1;
+		prefetchHits_ = 0;
+		prefetchOccupancy_ = 0;
+		prefetchMisses_ = 0;
+		for (auto& count : refillLatency_)
+		{
+			count = 0;
+		}
+	}
+	//Zn߂Oɐݒ肷邱
+	void SetParent(SoundStats* parent)
+	{
+		parent_ = parent;
+	}
+	void AddUnderrun()
+	{
+		underruns_.fetch_add(1, std::memory_order_relaxed);
+		if (parent_ != nullptr)
+		{
+			parent_->AddUnderrun();
+		}
+	}
+	void AddRestart()
+	{
+		restarts_.fetch_add(1, std::memory_order_relaxed);
+		if (parent_ != nullptr)
+		{
+			parent_->AddRestart();
+		}
+	}
+	void AddBytesRead(std::uint64_t bytes)
+	{
+		bytesRead_.fetch_add(bytes, std::memory_order_relaxed);
+		if (parent_ != nullptr)
+		{
+			parent_->AddBytesRead(bytes);
+		}
+	}
+	//obt@1[Blatency͏ς݂ɂȂĂ[܂ł̎(}CNbAȂΕ)
+	void AddRefill(long long latency)
+	{
+		refills_.fetch_add(1, std::memory_order_relaxed);
+		if (latency >= 0)
+		{
+			int index = 0;
+			while (index < NumLatencyBucket - 1 && latency >= GetLatencyBucketLimit(index))
+			{
+				++index;
+			}
+			refillLatency_[index].fetch_add(1, std::memory_order_relaxed);
+		}
+		if (parent_ != nullptr)
+		{
+			parent_->AddRefill(latency);
+		}
+	}
+	//[O̍Đ҂obt@L^AŏlXV
+	void UpdateLowWaterMark(int numPending)
+	{
+		int current = lowWaterMark_.load(std::memory_order_relaxed);
+		while ((current < 0 || numPending < current) &&
+			!lowWaterMark_.compare_exchange_weak(current, numPending, std::memory_order_relaxed))
+		{
+		}
+		if (parent_ != nullptr)
+		{
+			parent_->UpdateLowWaterMark(numPending);
+		}
+	}
+	//ǂ݃OubN1oBnumReady͎oOɃOɂ
+	void AddPrefetchHit(int numReady)
+	{
+		prefetchHits_.fetch_add(1, std::memory_order_relaxed);
+		prefetchOccupancy_.fetch_add(numReady, std::memory_order_relaxed);
+		if (parent_ != nullptr)
+		{
+			parent_->AddPrefetchHit(numReady);
+		}
+	}
+	void AddPrefetchMiss()
+	{
+		prefetchMisses_.fetch_add(1, std::memory_order_relaxed);
+		if (parent_ != nullptr)
+		{
+			parent_->AddPrefetchMiss();
+		}
+	}
+	Snapshot GetSnapshot() const
+	{
+		Snapshot snapshot;
+		snapshot.underruns = underruns_.load(std::memory_order_relaxed);
+		snapshot.restarts = restarts_.load(std::memory_order_relaxed);
+		snapshot.refills = refills_.load(std::memory_order_relaxed);
+		snapshot.bytesRead = bytesRead_.load(std::memory_order_relaxed);
+		snapshot.lowWaterMark = lowWaterMark_.load(std::memory_order_relaxed);
+		for (int i = 0; i < NumLatencyBucket; ++i)
+		{
+			snapshot.refillLatency[i] = refillLatency_[i].load(std::memory_order_relaxed);
+		}
+		snapshot.prefetchHits = prefetchHits_.load(std::memory_order_relaxed);
+		snapshot.prefetchOccupancy = prefetchOccupancy_.load(std::memory_order_relaxed);
+		snapshot.prefetchMisses = prefetchMisses_.load(std::memory_order_relaxed);
+		return snapshot;
+	}
+};
@@ -1,12 +1,29 @@
 #include <iostream>
+#ifdef _WIN32
 #include <conio.h>
+#else
+#include <cstdio>
+//conio.h̖ł͕W͂1ǂ
+static int _getch() { return getchar(); }
+#endif
 #include "wav.h"
 #include "Audio.hpp"
+#include "Benchmark.hpp"
+#include "PackedBankBuilder.hpp"
 #include <vector>
 
-int main()
+int main(int argc, char* argv[])
 {
-	
+	//v[h
+	if (argc >= 2 && strcmp(argv[1], "bench") == 0)
+	{
+		return SoundBenchmark::Run(argc, argv);
+	}
+	//WAV܂Ƃ߂oN
+	if (argc >= 2 && strcmp(argv[1], "pack") == 0)
+	{
+		return PackedBankBuilder::Run(argc, argv);
+	}
 
 	using namespace std;
 	WAVE          wav1;
@@ -33,18 +50,25 @@ int main()
 	cout << endl;
 
 	SoundClass Soundsystem;
-	Soundsystem.CreateSource("test", "lastcastle_16bit.wav", SoundSource::LoadMode::Streaming);
-	
+	//񖼑OňÃnhŐG
+	SoundHandle test = Soundsystem.CreateSourceHandle("test", "lastcastle_16bit.wav", SoundSource::LoadMode::Streaming);
+	//OdȂĂΖȃnhԂ
+	SoundSource* source = Soundsystem.GetSource(test);
+	if (source == nullptr)
+	{
+		cout << "can't create source" << endl;
+		return 1;
+	}
 	
 	while (1)
 	{
 		switch (_getch())
 		{
 		case 'z':
-			Soundsystem.GetSource("test")->Play(true);
+			source->Play(true);
 			break;
 		case 'x':
-			Soundsystem.GetSource("test")->Pause();
+			source->Pause();
 			break;
 		}
 
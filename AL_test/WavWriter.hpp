@@ -0,0 +1,114 @@
+#pragma once
+#include <cstdint>
+#include <fstream>
+
+//PCMWAVt@Cɏo
+//wb_[͉̒̒lŏĂACloseŏ̂őŜɎȂĂ悢
+//(WAVE::save_to_file͑SdataɑĂ珑̂ŁA`ɂ͌Ȃ)
+class WavWriter
+{
+private:
+	std::ofstream file_;
+	int blockSize_;
+	long long dataBytes_;
+
+	//ꉞRs[֎~
+	WavWriter(const WavWriter&) = delete;
+	WavWriter& operator=(const WavWriter&) = delete;
+public:
+	//RIFF̒32bitȂ̂ŁA𒴂镪͏Ȃ
+	static const long long MaxDataBytes = 0xFFFFFFFFLL - 36;
+
+	WavWriter()
+	{
+		blockSize_ = 0;
+		dataBytes_ = 0;
+	}
+	~WavWriter()
+	{
+		Close();
+	}
+	//bitsPerSample8/16/24bit̐32(float)
+	bool Open(const char* filePass, int channels, int bitsPerSample, int samplingRate)
+	{
+		Close();
+		file_.open(filePass, std::ios::binary | std::ios::trunc);
+		if (!file_) {
+			return false;
+		}
+		blockSize_ = channels * bitsPerSample / 8;
+		dataBytes_ = 0;
+
+		//fmt`NPCMfloat16oCg (͌ŏ)
+		std::uint16_t formatId = bitsPerSample == 32 ? 3 : 1;
+		file_.write("RIFF", 4);
+		WriteU32(0);
+		file_.write("WAVE", 4);
+		file_.write("fmt ", 4);
+		WriteU32(16);
+		WriteU16(formatId);
+		WriteU16((std::uint16_t)channels);
+		WriteU32((std::uint32_t)samplingRate);
+		WriteU32((std::uint32_t)(samplingRate * blockSize_));
+		WriteU16((std::uint16_t)blockSize_);
+		WriteU16((std::uint16_t)bitsPerSample);
+		file_.write("data", 4);
+		WriteU32(0);
+		return (bool)file_;
+	}
+	//framesgɏBȂ̏𒴂false
+	bool Write(const void* pcm, int frames)
+	{
+		if (!file_.is_open()) {
+			return false;
+		}
+		long long bytes = (long long)frames * blockSize_;
+		if (dataBytes_ + bytes > MaxDataBytes) {
+			return false;
+		}
+		file_.write((const char*)pcm, bytes);
+		if (!file_) {
+			return false;
+		}
+		dataBytes_ += bytes;
+		return true;
+	}
+	//ĕ
+	bool Close()
+	{
+		if (!file_.is_open()) {
+			return false;
+		}
+		//data`N̒Ȃlߕ1oCg
+		if (dataBytes_ & 1) {
+			file_.put(0);
+		}
+		file_.seekp(4, std::ios::beg);
+		WriteU32((std::uint32_t)(36 + dataBytes_ + (dataBytes_ & 1)));
+		file_.seekp(40, std::ios::beg);
+		WriteU32((std::uint32_t)dataBytes_);
+		bool isGood = (bool)file_;
+		file_.close();
+		return isGood;
+	}
+	bool IsOpen() const
+	{
+		return file_.is_open();
+	}
+	long long GetFrames() const
+	{
+		return blockSize_ > 0 ? dataBytes_ / blockSize_ : 0;
+	}
+private:
+	//WAV̓gGfBA
+	void WriteU16(std::uint16_t value)
+	{
+		char bytes[2] = { (char)(value & 0xff), (char)(value >> 8) };
+		file_.write(bytes, 2);
+	}
+	void WriteU32(std::uint32_t value)
+	{
+		char bytes[4] = { (char)(value & 0xff), (char)((value >> 8) & 0xff), (char)((value >> 16) & 0xff), (char)(value >> 24) };
+		file_.write(bytes, 4);
+	}
+};
@@ -0,0 +1,108 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+//t@C̓ǂݍ݂ȂǎԂ̂鏈𗠂ŏɕЕtXbhv[
+//j鎞͐ς܂Ă鏈SI点ĂXbh~߂
+class WorkerPool
+{
+private:
+	std::mutex mutex_;
+	std::condition_variable cv_;
+	//WaitIdleő҂ĂXbhɒm点
+	std::condition_variable idleCv_;
+	std::queue<std::function<void()>> jobs_;
+	std::vector<std::thread> threads_;
+	//s̏̐
+	int numRunning_;
+	bool isEnd_;
+
+	//ꉞRs[֎~
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+public:
+	WorkerPool(int numThread = 2)
+	{
+		isEnd_ = false;
+		numRunning_ = 0;
+		if (numThread < 1)
+		{
+			numThread = 1;
+		}
+		for (int i = 0; i < numThread; ++i)
+		{
+			threads_.emplace_back(&WorkerPool::WorkerThread, this);
+		}
+	}
+	~WorkerPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			isEnd_ = true;
+		}
+		cv_.notify_all();
+		for (auto& thread : threads_)
+		{
+			thread.join();
+		}
+	}
+	//ςŁA̖߂l󂯎futureԂ
+	template<class Func>
+	auto Push(Func func) -> std::future<decltype(func())>
+	{
+		using Result = decltype(func());
+		auto task = std::make_shared<std::packaged_task<Result()>>(std::move(func));
+		std::future<Result> result = task->get_future();
+		{
+			std::lock_guard<std::mutex> lock(mutex_);
+			jobs_.push([task] { (*task)(); });
+		}
+		cv_.notify_one();
+		return result;
+	}
+	//ς܂Ă鏈Ǝs̏SI܂ő҂
+	//(҂ĂԂɐς܂ꂽI܂ő҂)
+	void WaitIdle()
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		idleCv_.wait(lock, [this] { return jobs_.empty() && numRunning_ == 0; });
+	}
+	int GetNumThread() const
+	{
+		return (int)threads_.size();
+	}
+private:
+	void WorkerThread()
+	{
+		for (;;)
+		{
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(mutex_);
+				cv_.wait(lock, [this] { return isEnd_ || !jobs_.empty(); });
+				//Iς܂Ă镪͕Еt
+				if (jobs_.empty())
+				{
+					return;
+				}
+				job = std::move(jobs_.front());
+				jobs_.pop();
+				++numRunning_;
+			}
+			job();
+			{
+				std::lock_guard<std::mutex> lock(mutex_);
+				if (--numRunning_ == 0 && jobs_.empty())
+				{
+					idleCv_.notify_all();
+				}
+			}
+		}
+	}
+};
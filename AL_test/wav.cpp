@@ -2,9 +2,12 @@
 //---------------------------------------------------------------------------
 #define _CRT_SECURE_NO_WARNINGS
 #include "wav.h"
+#include "SampleConverter.hpp"
+#include "MappedFile.hpp"
 #include <iostream>
 #include <fstream>
 #include <cassert>
+#include <cstring>
 #include <algorithm>
 #include <functional>
 
@@ -18,30 +21,60 @@ struct WAVECHUNK
 	char ID[4];     //`N̎
 	int  size;      //`ÑTCY
 };
+//ubNPʂœǂގ̏
+//---------------------------------------------------------------------------
+struct WAVE::BLOCK_STATE
+{
+	MappedFile map;
+	const unsigned char *pcm;           //}bvłdata`N̐擪
+	ifstream file;                      //}bvłȂ͂ǂ
+	unsigned long data_offset;          //t@C擪data`N̒g܂ł̃oCg
+	unsigned long block_frames;
+	unsigned long position;             //ɓǂޑg
+	vector<unsigned char> raw;          //t@Cǂ1ubN
+	vector<short> s16;                  //16bitȊO16bitɂ낦1ubN (`l͕񂾂܂)
+};
+//---------------------------------------------------------------------------
+//񂾂܂܂̃Tvcount16bitɂ낦
+static void convert_to_s16(const unsigned char *src, short *dst, size_t count, const WAVE_FORMAT &fmt)
+{
+	if (fmt.bits_per_sample == 8) {
+		SampleConverter::U8ToS16(src, dst, count);
+	}
+	else if (fmt.bits_per_sample == 16) {
+		memcpy(dst, src, count * sizeof(short));
+	}
+	else if (fmt.bits_per_sample == 24) {
+		SampleConverter::S24ToS16(src, dst, count);
+	}
+	else if (fmt.format_id == 3) {
+		SampleConverter::F32ToS16((const float*)src, dst, count);
+	}
+}
 //---------------------------------------------------------------------------
 WAVE::WAVE()
 {
 	sampling_size = 0;
 	data_size = 0;
+	blocks = nullptr;
 }
 //---------------------------------------------------------------------------
 WAVE::WAVE(char *file_name)
 {
+	blocks = nullptr;
 	load_from_file(file_name);
 }
 //---------------------------------------------------------------------------
 WAVE::~WAVE()
 {
-
+	close_blocks();
 }
 //---------------------------------------------------------------------------
 bool WAVE::load_from_file(const char *file_name)
 {
-	WAVECHUNK chunk;
-	char      type[4];
-
 	ifstream ifs(file_name, ios::binary);
 
+	close_blocks();
 	data.clear();
 	//sampling_size=0;
 	data_size = 0;
@@ -51,6 +84,44 @@ bool WAVE::load_from_file(const char *file_name)
 		return false;
 	}
 
+	unsigned long data_offset = 0;
+	unsigned long data_bytes = 0;
+	if (!read_header(ifs, data_offset, data_bytes)) {
+		goto WAVE_FILE_ERROR;
+	}
+
+	try {
+		ifs.exceptions(ios::badbit);
+		data.resize(data_bytes);
+		if (data_bytes > 0) {
+			ifs.read((char*)&data[0], data.size());
+		}
+	}
+	catch (ios_base::failure& e) {
+		cerr << e.what() << endl;
+		goto WAVE_FILE_ERROR;
+	}
+
+	sampling_size = fmt.bits_per_sample / 8 * fmt.num_of_channels;
+	data_size = data.size() / sampling_size;
+
+	return true;
+
+	//G[̏
+WAVE_FILE_ERROR:
+	data.clear();
+	sampling_size = 0;
+	data_size = 0;
+
+	return false;
+}
+//---------------------------------------------------------------------------
+//RIFFwb_[fmt`N܂łǂ݁Adata`N̒g̐擪Ŏ~߂
+bool WAVE::read_header(istream &ifs, unsigned long &data_offset, unsigned long &data_bytes)
+{
+	WAVECHUNK chunk;
+	char      type[4];
+
 	ifs.read((char*)&chunk, 8);
 	if (ifs.bad() || strncmp(chunk.ID, "RIFF", 4) != 0) return false;
 
@@ -64,50 +135,172 @@ bool WAVE::load_from_file(const char *file_name)
 		ifs.exceptions(ios::badbit);
 		while (ifs.read((char*)&chunk, sizeof(WAVECHUNK))) {
 			if (strncmp(chunk.ID, "fmt ", 4) == 0) {
-				//jAPCAɂ̂ݑΉ : sizeof(WAVE_FORMAT) = 16
-				ifs.read((char*)&fmt, min(16, chunk.size));
-
-				//jAPCAłȂ甲
-				if (fmt.format_id != 1) {
+				//擪16oCg(sizeof(WAVE_FORMAT))̌ɊgƂ̂ŁA`N͑Sǂ
+				int fmt_size = chunk.size + (chunk.size & 1);
+				vector<unsigned char> fmt_chunk(max(16, fmt_size));
+				ifs.read((char*)&fmt_chunk[0], fmt_size);
+				memcpy(&fmt, &fmt_chunk[0], 16);
+
+				//WAVE_FORMAT_EXTENSIBLESubFormat(g8oCgڂ)̐擪2oCg{̃tH[}bgID
+				if (fmt.format_id == 0xFFFE && chunk.size >= 40) {
+					fmt.format_id = fmt_chunk[24] | (fmt_chunk[25] << 8);
+				}
+				//jAPCM(8/16/24bit)32bit floatłȂ甲
+				bool is_pcm = fmt.format_id == 1 && (fmt.bits_per_sample == 8 || fmt.bits_per_sample == 16 || fmt.bits_per_sample == 24);
+				bool is_float = fmt.format_id == 3 && fmt.bits_per_sample == 32;
+				if (!is_pcm && !is_float) {
 					cerr << "unsupported wave file format." << endl;
-					goto WAVE_FILE_ERROR;
+					return false;
+				}
+				//`lƂɕĎô̓mƃXeI (4ch,6chEXTENSIBLEe)
+				if (fmt.num_of_channels != 1 && fmt.num_of_channels != 2) {
+					cerr << "unsupported number of channels." << endl;
+					return false;
 				}
 				flg++;
 			}
 			else if (strncmp(chunk.ID, "data", 4) == 0) {
-				data.resize(chunk.size);
-				ifs.read((char*)&data[0], data.size());
+				data_offset = (unsigned long)ifs.tellg();
+				data_bytes = (unsigned long)chunk.size;
 
 				flg++;
 				break;
 			}
 			else {
-				ifs.seekg(chunk.size, ios::cur);
+				ifs.seekg(chunk.size + (chunk.size & 1), ios::cur);
 			}
 		}
 	}
 	catch (ios_base::failure& e) {
 		cerr << e.what() << endl;
-		goto WAVE_FILE_ERROR;
+		return false;
 	}
 
 	if (flg != 2) {
 		cerr << "file format error." << endl;
-		goto WAVE_FILE_ERROR;
+		return false;
 	}
-
-	sampling_size = fmt.bits_per_sample / 8 * fmt.num_of_channels;
-	data_size = data.size() / sampling_size;
-
 	return true;
-
-	//G[̏
-WAVE_FILE_ERROR:
+}
+//---------------------------------------------------------------------------
+bool WAVE::open_blocks(const char *file_name, unsigned long block_frames)
+{
+	close_blocks();
 	data.clear();
 	sampling_size = 0;
 	data_size = 0;
 
-	return false;
+	if (block_frames == 0) return false;
+
+	ifstream ifs(file_name, ios::binary);
+	if (!ifs) {
+		cerr << "file open error." << endl;
+		return false;
+	}
+	unsigned long data_offset = 0;
+	unsigned long data_bytes = 0;
+	if (!read_header(ifs, data_offset, data_bytes)) return false;
+
+	//data`NrŐ؂Ăt@Cɂ镪
+	ifs.clear();
+	ifs.seekg(0, ios::end);
+	unsigned long file_size = (unsigned long)ifs.tellg();
+	if (file_size < data_offset) return false;
+	data_bytes = min(data_bytes, file_size - data_offset);
+
+	sampling_size = fmt.bits_per_sample / 8 * fmt.num_of_channels;
+	data_size = data_bytes / sampling_size;
+
+	blocks = new BLOCK_STATE();
+	blocks->pcm = nullptr;
+	blocks->data_offset = data_offset;
+	blocks->block_frames = block_frames;
+	blocks->position = 0;
+	if (fmt.bits_per_sample != 16) {
+		blocks->s16.resize(block_frames * fmt.num_of_channels);
+	}
+	if (blocks->map.Open(file_name) && blocks->map.GetSize() >= data_offset + data_bytes) {
+		blocks->pcm = (const unsigned char*)blocks->map.GetData() + data_offset;
+	}
+	else {
+		//}bvłȂł1ubNǂ
+		blocks->map.Close();
+		blocks->file.open(file_name, ios::binary);
+		if (!blocks->file) {
+			close_blocks();
+			return false;
+		}
+		blocks->file.seekg(data_offset, ios::beg);
+		blocks->raw.resize(block_frames * sampling_size);
+	}
+	return true;
+}
+//---------------------------------------------------------------------------
+unsigned long WAVE::read_block(short *ch0, short *ch1)
+{
+	if (blocks == nullptr || blocks->position >= data_size) return 0;
+
+	unsigned long frames = min(blocks->block_frames, data_size - blocks->position);
+	const unsigned char *src;
+	if (blocks->pcm != nullptr) {
+		src = blocks->pcm + (size_t)blocks->position * sampling_size;
+	}
+	else {
+		blocks->file.read((char*)&blocks->raw[0], frames * sampling_size);
+		frames = (unsigned long)blocks->file.gcount() / sampling_size;
+		src = &blocks->raw[0];
+	}
+	if (frames == 0) return 0;
+
+	//16bit͂̂܂܁AȊO16bitɂ낦Ă`lƂɕ
+	const short *s16 = (const short*)src;
+	if (fmt.bits_per_sample != 16) {
+		convert_to_s16(src, &blocks->s16[0], frames * fmt.num_of_channels, fmt);
+		s16 = &blocks->s16[0];
+	}
+	if (fmt.num_of_channels == 1) {
+		if (ch0 != nullptr) memcpy(ch0, s16, frames * sizeof(short));
+	}
+	else {
+		SampleConverter::DeinterleaveS16(s16, ch0, ch1, frames);
+	}
+	blocks->position += frames;
+	return frames;
+}
+//---------------------------------------------------------------------------
+unsigned long WAVE::read_block(vector<short> &ch0, vector<short> &ch1)
+{
+	if (blocks == nullptr) return 0;
+
+	bool is_stereo = fmt.num_of_channels == 2;
+	ch0.resize(blocks->block_frames);
+	ch1.resize(is_stereo ? blocks->block_frames : 0);
+	unsigned long frames = read_block(&ch0[0], is_stereo ? &ch1[0] : nullptr);
+	ch0.resize(frames);
+	if (is_stereo) ch1.resize(frames);
+	return frames;
+}
+//---------------------------------------------------------------------------
+void WAVE::seek_blocks(unsigned long frame)
+{
+	if (blocks == nullptr) return;
+
+	blocks->position = min(frame, data_size);
+	if (blocks->pcm == nullptr) {
+		blocks->file.clear();
+		blocks->file.seekg(blocks->data_offset + (streamoff)blocks->position * sampling_size, ios::beg);
+	}
+}
+//---------------------------------------------------------------------------
+unsigned long WAVE::block_position()
+{
+	return blocks != nullptr ? blocks->position : 0;
+}
+//---------------------------------------------------------------------------
+void WAVE::close_blocks()
+{
+	delete blocks;
+	blocks = nullptr;
 }
 //---------------------------------------------------------------------------
 bool WAVE::save_to_file(const char *file_name)
@@ -148,35 +341,87 @@ bool WAVE::save_to_file(const char *file_name)
 	return true;
 }
 //---------------------------------------------------------------------------
+void WAVE::get_s16(vector<short> &buf)
+{
+	//24bitfloatS`l񂾂܂16bitɂ
+	size_t count = data_size * fmt.num_of_channels;
+	buf.resize(count);
+	if (count == 0) return;
+
+	convert_to_s16(&data[0], &buf[0], count, fmt);
+}
+//---------------------------------------------------------------------------
 void WAVE::get_channel(vector<short> &channel, unsigned short ch)
 {
+	//open_blocksŊJĂԂdataɉ
+	if (data.empty()) {
+		channel.clear();
+		return;
+	}
 	channel.resize(data_size);
+	if (data_size == 0) return;
+
+	if (fmt.bits_per_sample != 8 && fmt.bits_per_sample != 16) {
+		//24bitfloat͈x16bitɂĂo
+		vector<short> s16;
+		get_s16(s16);
+		if (fmt.num_of_channels == 1) {
+			channel.swap(s16);
+		}
+		else {
+			if (ch > 1) ch = 1;
+			SampleConverter::DeinterleaveS16(&s16[0], ch == 0 ? &channel[0] : nullptr, ch == 1 ? &channel[0] : nullptr, data_size);
+		}
+		return;
+	}
+
 	if (fmt.num_of_channels == 1) {
 		if (fmt.bits_per_sample == 8) {
 			//8bitȂf[^ unsigned char (0`255  128)Ȃ̂ŕ␳
-			for (auto t(0u); t < data_size; t++) channel[t] = (short(data[t]) - 0x80) << 8;
+			SampleConverter::U8ToS16(&data[0], &channel[0], data_size);
 		}
 		else if (fmt.bits_per_sample == 16) {
 			//16bitȂf[^ signed short (-32768`+32767  0)
-			short *ptr = (short*)&data[0];
-			for (auto t(0u); t < data_size; t++) channel[t] = ptr[t];
+			memcpy(&channel[0], &data[0], data_size * sizeof(short));
 		}
 	}
 	else if (fmt.num_of_channels == 2) {
 		if (ch > 1) ch = 1;
 
 		if (fmt.bits_per_sample == 8) {
-			//8bitȂf[^ unsigned char (0`255  128)Ȃ̂ŕ␳
-			for (auto t(0u); t < data_size; t++) channel[t] = (short(data[2 * t + ch]) - 0x80) << 8;
+			//8bitȂf[^ unsigned char (0`255  128)Ȃ̂ŕ␳Ăo
+			vector<short> stereo(2 * data_size);
+			SampleConverter::U8ToS16(&data[0], &stereo[0], 2 * data_size);
+			SampleConverter::DeinterleaveS16(&stereo[0], ch == 0 ? &channel[0] : nullptr, ch == 1 ? &channel[0] : nullptr, data_size);
 		}
 		else if (fmt.bits_per_sample == 16) {
 			//16bitȂf[^ signed short (-32768`+32767  0)
 			short *ptr = (short*)&data[0];
-			for (auto t(0u); t < data_size; t++) channel[t] = ptr[2 * t + ch];
+			SampleConverter::DeinterleaveS16(ptr, ch == 0 ? &channel[0] : nullptr, ch == 1 ? &channel[0] : nullptr, data_size);
 		}
 	}
 }
 //---------------------------------------------------------------------------
+void WAVE::get_mono(vector<short> &channel)
+{
+	//mȂ炻̂܂܁AXeIȂ獶E̕
+	if (fmt.num_of_channels != 2 || data.empty()) {
+		get_channel(channel, 0);
+		return;
+	}
+	channel.resize(data_size);
+	if (data_size == 0) return;
+
+	if (fmt.bits_per_sample == 16) {
+		SampleConverter::DownmixS16((short*)&data[0], &channel[0], data_size);
+	}
+	else {
+		vector<short> stereo;
+		get_s16(stereo);
+		SampleConverter::DownmixS16(&stereo[0], &channel[0], data_size);
+	}
+}
+//---------------------------------------------------------------------------
 void WAVE::set_channel(std::vector<short> &ch0, WAVE_FORMAT _fmt)
 {
 	fmt = _fmt;
@@ -195,13 +440,13 @@ void WAVE::set_channel(std::vector<short> &ch0, WAVE_FORMAT _fmt)
 	data_size = ch0.size();
 
 	data.resize(sampling_size*ch0.size());
+	if (data_size == 0) return;
 
 	if (BPS == 1) {
-		for (auto t(0u); t < ch0.size(); t++) data[t] = (ch0[t] >> 8) + 0x80;
+		SampleConverter::S16ToU8(&ch0[0], &data[0], data_size);
 	}
 	else if (BPS == 2) {
-		short *ptr = (short*)&data[0];
-		for (auto t(0u); t < ch0.size(); t++) ptr[t] = ch0[t];
+		memcpy(&data[0], &ch0[0], data_size * sizeof(short));
 	}
 }
 //---------------------------------------------------------------------------
@@ -222,20 +467,18 @@ void WAVE::set_channel(std::vector<short> &ch0, std::vector<short> &ch1, WAVE_FO
 	sampling_size = BPS * fmt.num_of_channels;
 	data_size = min(ch0.size(), ch1.size());
 
-	data.resize(sampling_size*ch0.size());
+	//Ⴄꍇ͒Zɑ
+	data.resize(sampling_size*data_size);
+	if (data_size == 0) return;
 
 	if (BPS == 1) {
-		for (auto t(0u); t < data_size; t++) {
-			data[2 * t] = (ch0[t] >> 8) + 0x80;
-			data[2 * t + 1] = (ch1[t] >> 8) + 0x80;
-		}
+		vector<short> stereo(2 * data_size);
+		SampleConverter::InterleaveS16(&ch0[0], &ch1[0], &stereo[0], data_size);
+		SampleConverter::S16ToU8(&stereo[0], &data[0], 2 * data_size);
 	}
 	else if (BPS == 2) {
 		short *ptr = (short*)&data[0];
-		for (auto t(0u); t < data_size; t++) {
-			ptr[2 * t] = ch0[t];
-			ptr[2 * t + 1] = ch1[t];
-		}
+		SampleConverter::InterleaveS16(&ch0[0], &ch1[0], ptr, data_size);
 	}
 }
-//---------------------------------------------------------------------------
\ No newline at end of file
+//---------------------------------------------------------------------------
@@ -4,16 +4,19 @@
 
 //---------------------------------------------------------------------------
 #include <vector>
+#include <cstdint>
+#include <istream>
 
 //---------------------------------------------------------------------------
 struct WAVE_FORMAT
 {
-	unsigned short format_id;           //tH[}bgID
-	unsigned short num_of_channels;     //`l monaural=1 , stereo=2
-	unsigned long  samples_per_sec;     //PbԂ̃TvCTvO[g(Hz)
-	unsigned long  bytes_per_sec;       //PbԂ̃f[^TCY
-	unsigned short block_size;          //PubÑTCYD8bit:nomaural=1byte , 16bit:stereo=4byte
-	unsigned short bits_per_sample;     //PTṽrbg 8bit or 16bit
+	//t@C̕т̂܂܂Ȃ̂ŁAlong 64bit̊łȂ悤Œ肷
+	std::uint16_t format_id;            //tH[}bgID (1=PCM, 3=floatBWAVE_FORMAT_EXTENSIBLE͓ǂݍݎSubFormatIDɒu)
+	std::uint16_t num_of_channels;      //`l monaural=1 , stereo=2
+	std::uint32_t samples_per_sec;      //PbԂ̃TvCTvO[g(Hz)
+	std::uint32_t bytes_per_sec;        //PbԂ̃f[^TCY
+	std::uint16_t block_size;           //PubÑTCYD8bit:nomaural=1byte , 16bit:stereo=4byte
+	std::uint16_t bits_per_sample;      //PTṽrbg 8bit or 16bit or 24bit or 32bit(float)
 };
 //---------------------------------------------------------------------------
 class WAVE
@@ -29,15 +32,39 @@ private:
 	unsigned long sampling_size;        //TvOMTCY(bytes)
 	unsigned long data_size;            //f[^TCY
 
+	//ubNPʂœǂł鎞̏ (open_blocksclose_blocks܂)
+	struct BLOCK_STATE;
+	BLOCK_STATE *blocks;
+
+	bool read_header(std::istream &is, unsigned long &data_offset, unsigned long &data_bytes);
+	void get_s16(std::vector<short> &buf);
+
 public:
 	WAVE();
 	WAVE(char *file_name);
 	~WAVE();
 
+	//ǂ߂̂̓mƃXeÍA8/16/24bitPCM32bit float (ȊOfalse)
 	bool load_from_file(const char *file_name);
 	bool save_to_file(const char *file_name);
 
 	void get_channel(std::vector<short> &buf, unsigned short ch);
+	void get_mono(std::vector<short> &buf);
+
+	//t@CŜǂ܂ɁAblock_framesg`lƂɕĎo (dataɂ͓ǂݍ܂Ȃ)
+	//}bvł΃}bv̈悩AłȂ΃t@C1ubNǂނ̂ŁAɂ炸g͈
+	//JĂԂget_format/size/sec͎g
+	//load_from_fileƓAmƃXeIȊÕt@Cfalse
+	bool open_blocks(const char *file_name, unsigned long block_frames);
+	//̃ubN16bitɂch0,ch1ɏAgԂ (I[Ȃ0)
+	//ch0,ch1block_framesg̗̈ĂяoŗpӂĎg񂷁BvȂ`lnullptrł悢(mch1͎gȂ)
+	unsigned long read_block(short *ch0, short *ch1);
+	//vector̔ŁBǂ񂾑g̒ɂ邪Aeʂ͂̂܂܎ĉ2ڈȍ~͊mۂȂ (mch1͋ɂȂ)
+	unsigned long read_block(std::vector<short> &ch0, std::vector<short> &ch1);
+	//ɓǂވʒugPʂŕς (I[zI[)
+	void seek_blocks(unsigned long frame);
+	unsigned long block_position();
+	void close_blocks();
 
 	void set_channel(std::vector<short> &_ch0, WAVE_FORMAT _fmt);
 	void set_channel(std::vector<short> &_ch0, std::vector<short> &_ch1, WAVE_FORMAT _fmt);